@@ -1,11 +1,30 @@
 #include <sawControllers/mtsController.h>
+#include <cisstCommon/cmnXMLPath.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 
+#include <algorithm>
+
+#if (CISST_OS == CISST_LINUX)
+#include <alloca.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 mtsController::mtsController( const std::string& taskname,
 			      double period,
-			      osaCPUMask cpumask ) :
+			      osaCPUMask cpumask,
+			      int priority,
+			      bool lockmemory,
+			      size_t prefault ) :
   mtsTaskPeriodic( taskname, period, true ),
   cpumask( cpumask ),
+  priority( priority ),
+  lockmemory( lockmemory ),
+  prefault( prefault ),
   ctl( NULL ),
   mtsEnabled( false ) {
 
@@ -15,6 +34,10 @@ mtsController::mtsController( const std::string& taskname,
     StateTable.AddData( mtsEnabled, "Enabled" );
     ctl->AddCommandWriteState( StateTable, mtsEnabled, "Enable" );
 
+    StateTable.AddData( looptiming.Summary(), "LoopTiming" );
+    ctl->AddCommandReadState( StateTable, looptiming.Summary(), "GetLoopTiming" );
+    ctl->AddEventWrite( LoopTimingEvent, "LoopTiming", vctDoubleVec() );
+
   }
   else{
     CMN_LOG_RUN_ERROR << "Failed to create interface Control for " << GetName()
@@ -26,3 +49,89 @@ mtsController::mtsController( const std::string& taskname,
 
 mtsController::~mtsController(){}
 
+void mtsController::SetRealTime( osaCPUMask cpumask,
+				 int priority,
+				 bool lockmemory,
+				 size_t prefault ){
+  this->cpumask = cpumask;
+  this->priority = priority;
+  this->lockmemory = lockmemory;
+  this->prefault = prefault;
+}
+
+void mtsController::ConfigureRealTime( const std::string& filename ){
+
+  if( filename.empty() )
+    { return; }
+
+  cmnXMLPath config;
+  config.SetInputSource( filename );
+
+  int cpu;
+  if( config.GetXMLValue( "/controller/realtime", "@cpu", cpu ) && 0 <= cpu )
+    { cpumask = static_cast<osaCPUMask>( 1 ) << cpu; }
+  config.GetXMLValue( "/controller/realtime", "@priority", priority );
+  config.GetXMLValue( "/controller/realtime", "@lockmemory", lockmemory );
+  int bytes;
+  if( config.GetXMLValue( "/controller/realtime", "@prefault", bytes ) && 0 <= bytes )
+    { prefault = bytes; }
+
+  CMN_LOG_CLASS_INIT_VERBOSE << "ConfigureRealTime: " << GetName()
+			     << " cpumask " << cpumask
+			     << " priority " << priority
+			     << " lockmemory " << lockmemory
+			     << " prefault " << prefault << std::endl;
+
+}
+
+void mtsController::Startup(){
+
+  looptiming.Configure( GetPeriodicity() );
+
+  if( cpumask != OSA_CPUANY ){
+    osaCPUSetAffinity( cpumask );
+  }
+
+#if (CISST_OS == CISST_LINUX)
+  if( 0 < priority ){
+    struct sched_param param;
+    param.sched_priority = priority;
+    int error = pthread_setschedparam( pthread_self(), SCHED_FIFO, &param );
+    if( error != 0 ){
+      CMN_LOG_CLASS_INIT_ERROR << "Startup: failed to set SCHED_FIFO priority "
+			       << priority << " for " << GetName()
+			       << ": " << strerror( error ) << std::endl;
+    }
+  }
+
+  if( lockmemory ){
+    if( mlockall( MCL_CURRENT | MCL_FUTURE ) != 0 ){
+      CMN_LOG_CLASS_INIT_ERROR << "Startup: mlockall failed for " << GetName()
+			       << std::endl;
+    }
+    // keep freed memory in the process so it stays locked
+    mallopt( M_TRIM_THRESHOLD, -1 );
+    mallopt( M_MMAP_MAX, 0 );
+  }
+
+  if( 0 < prefault ){
+    // touch the stack and heap so page faults happen now, the stack
+    // is bounded to stay well within the task thread's stack
+    const size_t stacksize = std::min( prefault, static_cast<size_t>( MaxStackPrefault ) );
+    volatile char* stack = static_cast<volatile char*>( alloca( stacksize ) );
+    for( size_t i=0; i<stacksize; i+=sysconf( _SC_PAGESIZE ) )
+      { stack[i] = 0; }
+    char* heap = static_cast<char*>( malloc( prefault ) );
+    if( heap != NULL ){
+      memset( heap, 0, prefault );
+      free( heap );
+    }
+  }
+#else
+  if( 0 < priority || lockmemory || 0 < prefault ){
+    CMN_LOG_CLASS_INIT_WARNING << "Startup: real-time settings are only supported on Linux"
+			       << std::endl;
+  }
+#endif
+
+}
@@ -1,7 +1,5 @@
 #include <sawControllers/mtsGravityCompensation.h>
 #include <cisstMultiTask/mtsInterfaceRequired.h>
-#include <cisstParameterTypes/prmPositionJointGet.h>
-#include <cisstParameterTypes/prmForceTorqueJointSet.h>
 
 mtsGravityCompensation::mtsGravityCompensation( const std::string& taskname,
 						double period,
@@ -28,32 +26,50 @@ mtsGravityCompensation::~mtsGravityCompensation(){
 
 }
 
-void mtsGravityCompensation::Configure( const std::string& ){}
+void mtsGravityCompensation::Configure( const std::string& filename )
+{ ConfigureRealTime( filename ); }
 
 void mtsGravityCompensation::Startup(){
 
+  mtsController::Startup();
+
+  // size the buffers so Run doesn't allocate
+  if( GC != NULL ){
+    prmq.SetSize( GC->links.size() );
+    prmq.Position().SetAll( 0.0 );
+    prmtau.SetSize( GC->links.size() );
+    prmtau.ForceTorque().SetAll( 0.0 );
+  }
+
 }
 
 void mtsGravityCompensation::Run(){
+  looptiming.BeginTick();
   ProcessQueuedCommands();
 
-  prmPositionJointGet prmq;
-  GetPositions( prmq );
+  // don't use stale or uninitialized positions if the read failed
+  looptiming.BeginIO();
+  const bool measured = GetPositions( prmq ).IsOK();
+  looptiming.EndIO();
 
-  vctDynamicVector<double> tau( prmq.Position().size(), 0.0 );
   if( GC != NULL && IsEnabled() ){
 
-    if( GC->Evaluate( prmq.Position(), tau ) != 
+    if( !measured ||
+	GC->Evaluate( prmq.Position(), prmtau.ForceTorque() ) != 
       osaGravityCompensation::ESUCCESS ){
       CMN_LOG_RUN_ERROR << "Faile to evaluate the controller" << std::endl;
+      prmtau.ForceTorque().SetAll( 0.0 );
     }
 
-    prmForceTorqueJointSet t;
-    t.ForceTorque() = tau;
-    SetTorques( t );
+    looptiming.BeginIO();
+    SetTorques( prmtau );
+    looptiming.EndIO();
     
   }
 
+  if( looptiming.EndTick() )
+    { LoopTimingEvent( looptiming.Summary() ); }
+
 }
 
 void mtsGravityCompensation::Cleanup(){}
@@ -0,0 +1,122 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnLogger.h>
+#include <cisstMultiTask/mtsStateTable.h>
+#include <sawControllers/mtsLockstep.h>
+
+// tasks due within this margin run in the same step
+static const double mtsLockstepTolerance = 1.0e-9;
+
+mtsLockstep::mtsLockstep(void):
+    mTime(0.0),
+    mNumberOfRuns(0)
+{
+}
+
+bool mtsLockstep::AddTask(mtsTaskPeriodic * task)
+{
+    const double period = task->GetPeriodicity();
+    if (!(period > 0.0)) {
+        CMN_LOG_INIT_ERROR << "mtsLockstep::AddTask: task " << task->GetName()
+                           << " must have a positive period" << std::endl;
+        return false;
+    }
+    Entry entry;
+    entry.Task = task;
+    entry.PID = dynamic_cast<mtsPID *>(task);
+    if (entry.PID) {
+        entry.PID->SetVirtualClock(&mTime);
+    }
+    entry.Period = period;
+    entry.Count = 0;
+    mEntries.push_back(entry);
+    return true;
+}
+
+void mtsLockstep::AddScript(mtsScriptedIO * script)
+{
+    mScripts.push_back(script);
+}
+
+void mtsLockstep::Startup(void)
+{
+    mTime = 0.0;
+    mNumberOfRuns = 0;
+    for (size_t index = 0; index < mScripts.size(); ++index) {
+        mScripts[index]->SetTime(mTime);
+        mScripts[index]->Startup();
+    }
+    for (size_t index = 0; index < mEntries.size(); ++index) {
+        mEntries[index].Count = 0;
+        mEntries[index].Task->Startup();
+    }
+}
+
+void mtsLockstep::Step(void)
+{
+    if (mEntries.empty()) {
+        return;
+    }
+
+    // earliest due task, computed from counts to avoid accumulating errors
+    double next = mEntries[0].Next();
+    for (size_t index = 1; index < mEntries.size(); ++index) {
+        if (mEntries[index].Next() < next) {
+            next = mEntries[index].Next();
+        }
+    }
+    mTime = next;
+
+    for (size_t index = 0; index < mScripts.size(); ++index) {
+        mScripts[index]->SetTime(mTime);
+    }
+
+    for (size_t index = 0; index < mEntries.size(); ++index) {
+        Entry & entry = mEntries[index];
+        if (entry.Next() > (mTime + mtsLockstepTolerance)) {
+            continue;
+        }
+        // same sequence as a task thread
+        mtsStateTable * stateTable = entry.Task->GetDefaultStateTable();
+        stateTable->Start();
+        stateTable->Tic = mTime;
+        stateTable->Period = entry.Period;
+        entry.Task->Run();
+        stateTable->Advance();
+        if (entry.PID) {
+            entry.PID->DrainEvents();
+        }
+        entry.Count++;
+        mNumberOfRuns++;
+    }
+}
+
+void mtsLockstep::RunUntil(const double time)
+{
+    while (!mEntries.empty() && (mTime < time)) {
+        Step();
+    }
+}
+
+void mtsLockstep::Cleanup(void)
+{
+    for (size_t index = 0; index < mEntries.size(); ++index) {
+        mEntries[index].Task->Cleanup();
+    }
+}
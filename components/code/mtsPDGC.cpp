@@ -1,7 +1,5 @@
 #include <sawControllers/mtsPDGC.h>
 #include <cisstMultiTask/mtsInterfaceRequired.h>
-#include <cisstParameterTypes/prmPositionJointGet.h>
-#include <cisstParameterTypes/prmForceTorqueJointSet.h>
 
 mtsPDGC::mtsPDGC( const std::string& taskname,
 		  double period,
@@ -33,41 +31,54 @@ mtsPDGC::~mtsPDGC(){
 
 }
 
-void mtsPDGC::Configure( const std::string& ){}
+void mtsPDGC::Configure( const std::string& filename )
+{ ConfigureRealTime( filename ); }
 
 void mtsPDGC::Startup(){
 
-  osaCPUSetAffinity( OSA_CPU3 );
+  mtsController::Startup();
+
+  // size the buffers so Run doesn't allocate
+  if( PDGC != NULL ){
+    prmqs.SetSize( PDGC->links.size() );
+    prmqs.Position().SetAll( 0.0 );
+    prmq.SetSize( PDGC->links.size() );
+    prmq.Position().SetAll( 0.0 );
+    prmtau.SetSize( PDGC->links.size() );
+    prmtau.ForceTorque().SetAll( 0.0 );
+  }
 
 }
 
 void mtsPDGC::Run(){
+  looptiming.BeginTick();
   ProcessQueuedCommands();
 
-  prmPositionJointGet prmqs;
-  GetDesiredPositions( prmqs );
-
-  prmPositionJointGet prmq;
-  GetFeedbackPositions( prmq );
+  // don't use stale or uninitialized positions if a read failed
+  looptiming.BeginIO();
+  const bool desired = GetDesiredPositions( prmqs ).IsOK();
+  const bool measured = GetFeedbackPositions( prmq ).IsOK();
+  looptiming.EndIO();
 
-  vctDynamicVector<double> tau( prmq.Position().size(), 0.0 );
   if( PDGC != NULL && IsEnabled() ){
 
-    vctDynamicVector<double> qs = prmqs.Position();
-    vctDynamicVector<double> q  = prmq.Position();
-    //std::cout << "qs: " << qs << std::endl
-    //      << "q : " << q << std::endl << std::endl;
-
     double dt = GetPeriodicity();
-    if( PDGC->Evaluate( qs, q, tau, dt ) != osaPDGC::ESUCCESS )
-      { CMN_LOG_RUN_ERROR << "Faile to evaluate the controller" << std::endl; }
-
-    prmForceTorqueJointSet t;
-    t.ForceTorque() = tau;
-    SetTorques( t );
+    if( !desired || !measured ||
+	PDGC->Evaluate( prmqs.Position(), prmq.Position(),
+			prmtau.ForceTorque(), dt ) != osaPDGC::ESUCCESS ){
+      CMN_LOG_RUN_ERROR << "Faile to evaluate the controller" << std::endl;
+      prmtau.ForceTorque().SetAll( 0.0 );
+    }
+
+    looptiming.BeginIO();
+    SetTorques( prmtau );
+    looptiming.EndIO();
     
   }
 
+  if( looptiming.EndTick() )
+    { LoopTimingEvent( looptiming.Summary() ); }
+
 }
 
 void mtsPDGC::Cleanup(){}
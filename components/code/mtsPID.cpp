@@ -16,8 +16,12 @@ http://www.cisst.org/cisst/license.txt.
 --- end cisst license ---
 */
 
-#include <cisstCommon/cmnXMLPath.h>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
 #include <cisstOSAbstraction/osaSleep.h>
+#include <cisstMultiTask/mtsGenericObjectProxy.h>
 #include <cisstMultiTask/mtsInterfaceRequired.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 
@@ -28,7 +32,8 @@ CMN_IMPLEMENT_SERVICES_DERIVED_ONEARG(mtsPID, mtsTaskPeriodic, mtsTaskPeriodicCo
 
 mtsPID::mtsPID(const std::string & componentName, const double periodInSeconds):
     mtsTaskPeriodic(componentName, periodInSeconds),
-    mConfigurationStateTable(100, "Configuration")
+    mEventHandler(this),
+    mConfigurationStateTable(10, "Configuration")
 {
     Init();
 }
@@ -36,7 +41,8 @@ mtsPID::mtsPID(const std::string & componentName, const double periodInSeconds):
 
 mtsPID::mtsPID(const mtsTaskPeriodicConstructorArg & arg):
     mtsTaskPeriodic(arg),
-    mConfigurationStateTable(100, "Configuration")
+    mEventHandler(this),
+    mConfigurationStateTable(10, "Configuration")
 {
     Init();
 }
@@ -49,6 +55,16 @@ void mtsPID::Init(void)
     mEnabled = false,
     mIsSimulated = false,
     mNumberOfActiveJoints = 0,
+    mKernel = &mKernelLocal;
+    mKernelFirst = 0;
+    mStateJointMeasureAccessor = 0;
+    mStateJointCommandAccessor = 0;
+    mGainsBundleAccessor = 0;
+    mHasPositionLimits = false;
+    mFeedForwardModel = 0;
+    mVirtualTime = 0;
+    mUseSimulatedPlant = false;
+    mSimulatedPlantTime = -1.0;
     AddStateTable(&mConfigurationStateTable);
     mConfigurationStateTable.SetAutomaticAdvance(false);
 }
@@ -71,30 +87,34 @@ void mtsPID::SetupInterfaces(void)
     }
 
     // this should go in "write" state table
-    StateTable.AddData(mEffortUserCommand, "EffortUserCommand");
-    // this should go in a "read" state table
-    StateTable.AddData(mEnabled, "Enabled");
-    StateTable.AddData(mJointsEnabled, "JointsEnabled");
-    StateTable.AddData(mPositionMeasure, "PositionMeasure");
-    StateTable.AddData(mVelocityMeasure, "VelocityMeasure");
-    StateTable.AddData(mEffortMeasure, "EffortMeasure");
-    StateTable.AddData(mCheckPositionLimit, "CheckPositionLimit");
-    StateTable.AddData(mGains.Offset, "EffortOffset");
-    StateTable.AddData(mStateJointMeasure, "StateJointMeasure");
-    StateTable.AddData(mStateJointCommand, "StateJointCommand");
+    mFootprint.AddData(StateTable, mEffortUserCommand, "EffortUserCommand");
+    // this should go in a "read" state table.  Measured positions,
+    // velocities and efforts are only saved once, in the joint state
+    mFootprint.AddData(StateTable, mEnabled, "Enabled");
+    mFootprint.AddData(StateTable, mJointsEnabled, "JointsEnabled");
+    mFootprint.AddData(StateTable, mCheckPositionLimit, "CheckPositionLimit");
+    mFootprint.AddData(StateTable, mGains.Offset, "EffortOffset");
+    // joint names are not saved in the state table, see GetStateJoint
+    mFootprint.AddData(StateTable, mStateJointMeasure, "StateJointMeasure");
+    mFootprint.AddData(StateTable, mStateJointCommand, "StateJointCommand");
+    mStateJointMeasureAccessor = StateTable.GetAccessorByInstance(mStateJointMeasure);
+    mStateJointCommandAccessor = StateTable.GetAccessorByInstance(mStateJointCommand);
 
     // configuration state table with occasional start/advance
-    mConfigurationStateTable.AddData(mGains.Kp, "Kp");
-    mConfigurationStateTable.AddData(mGains.Kd, "Kd");
-    mConfigurationStateTable.AddData(mGains.Ki, "Ki");
-    mConfigurationStateTable.AddData(mPositionLowerLimit, "PositionLowerLimit");
-    mConfigurationStateTable.AddData(mPositionUpperLimit, "PositionUpperLimit");
-    mConfigurationStateTable.AddData(mJointType, "JointType");
-    StateTable.AddData(mTrackingErrorEnabled, "EnableTrackingError"); // that table advances automatically
-    mConfigurationStateTable.AddData(mTrackingErrorTolerances, "TrackingErrorTolerances");
+    mFootprint.AddData(mConfigurationStateTable, mGains.Kp, "Kp");
+    mFootprint.AddData(mConfigurationStateTable, mGains.Kd, "Kd");
+    mFootprint.AddData(mConfigurationStateTable, mGains.Ki, "Ki");
+    mFootprint.AddData(mConfigurationStateTable, mPositionLowerLimit, "PositionLowerLimit");
+    mFootprint.AddData(mConfigurationStateTable, mPositionUpperLimit, "PositionUpperLimit");
+    mFootprint.AddData(mConfigurationStateTable, mJointType, "JointType");
+    mFootprint.AddData(StateTable, mTrackingErrorEnabled, "EnableTrackingError"); // that table advances automatically
+    mFootprint.AddData(mConfigurationStateTable, mTrackingErrorTolerances, "TrackingErrorTolerances");
+    mFootprint.AddData(mConfigurationStateTable, mGainsBundle, "Gains");
+    mGainsBundleAccessor = mConfigurationStateTable.GetAccessorByInstance(mGainsBundle);
 
     mInterface = AddInterfaceProvided("Controller");
     mInterface->AddMessageEvents();
+    mFootprint.AddData(StateTable, mLoopTiming.Summary(), "LoopTiming");
     if (mInterface) {
         mInterface->AddCommandVoid(&mtsPID::ResetController, this, "ResetController");
         mInterface->AddCommandWrite(&mtsPID::Enable, this, "Enable", false);
@@ -106,10 +126,13 @@ void mtsPID::SetupInterfaces(void)
         // set goals
         mInterface->AddCommandWrite(&mtsPID::SetDesiredPosition, this, "SetPositionJoint", prmPositionJointSet());
         mInterface->AddCommandWrite(&mtsPID::SetDesiredEffort, this, "SetTorqueJoint", prmForceTorqueJointSet());
+        mInterface->AddCommandWrite(&mtsPID::SetDesiredState, this, "SetStateJoint", prmStateJoint());
+        mInterface->AddCommandWrite(&mtsPID::SetGoalPosition, this, "SetPositionGoalJoint", prmPositionJointSet());
+        mInterface->AddEventWrite(Events.GoalReached, "GoalReached", false);
 
         // ROS compatible joint state
-        mInterface->AddCommandReadState(StateTable, mStateJointMeasure, "GetStateJoint");
-        mInterface->AddCommandReadState(StateTable, mStateJointCommand, "GetStateJointDesired");
+        mInterface->AddCommandRead(&mtsPID::GetStateJoint, this, "GetStateJoint", mStateJointMeasure);
+        mInterface->AddCommandRead(&mtsPID::GetStateJointDesired, this, "GetStateJointDesired", mStateJointCommand);
 
         // coupling
         mInterface->AddCommandWrite(&mtsPID::SetCoupling, this, "SetCoupling", prmActuatorJointCoupling());
@@ -139,6 +162,19 @@ void mtsPID::SetupInterfaces(void)
         mInterface->AddCommandWrite(&mtsPID::SetDGain, this, "SetDGain", mGains.Kd);
         mInterface->AddCommandWrite(&mtsPID::SetIGain, this, "SetIGain", mGains.Ki);
 
+        // all gains and limits at once, validated in the caller's thread
+        mInterface->AddCommandWrite(&mtsPID::SetGains, this, "SetGains",
+                                    mGainsBundle, MTS_COMMAND_NOT_QUEUED);
+        mInterface->AddCommandReadState(mConfigurationStateTable, mGainsBundle, "GetGains");
+        mInterface->AddCommandWrite(&mtsPID::ReloadConfiguration, this, "ReloadConfiguration",
+                                    std::string(""), MTS_COMMAND_NOT_QUEUED);
+
+        // gain scheduling, tables are built in the caller's thread
+        mInterface->AddCommandWrite(&mtsPID::LoadGainSchedule, this, "LoadGainSchedule",
+                                    std::string(""), MTS_COMMAND_NOT_QUEUED);
+        mInterface->AddCommandWrite(&mtsPID::SetGainScheduleVariable, this, "SetGainScheduleVariable",
+                                    mGainScheduleVariable);
+
         // Set joint limits
         mInterface->AddCommandWrite(&mtsPID::SetPositionLowerLimit, this, "SetPositionLowerLimit", mPositionLowerLimit);
         mInterface->AddCommandWrite(&mtsPID::SetPositionUpperLimit, this, "SetPositionUpperLimit", mPositionUpperLimit);
@@ -151,42 +187,76 @@ void mtsPID::SetupInterfaces(void)
         mInterface->AddEventWrite(Events.Enabled, "Enabled", false);
         mInterface->AddEventWrite(Events.EnabledJoints, "EnabledJoints", vctBoolVec());
         mInterface->AddEventWrite(Events.PositionLimit, "PositionLimit", vctBoolVec());
+
+        // Telemetry, not queued to keep file and thread operations out of the control loop
+        mInterface->AddCommandWrite(&mtsPID::StartTelemetry, this, "StartTelemetry",
+                                    std::string(""), MTS_COMMAND_NOT_QUEUED);
+        mInterface->AddCommandVoid(&mtsPID::StopTelemetry, this, "StopTelemetry",
+                                   MTS_COMMAND_NOT_QUEUED);
+
+        // Loop timing, see osaLoopTiming for the content
+        mInterface->AddCommandReadState(StateTable, mLoopTiming.Summary(), "GetLoopTiming");
+        mInterface->AddEventWrite(Events.LoopTiming, "LoopTiming", vctDoubleVec());
     }
 }
 
 void mtsPID::Configure(const std::string & filename)
 {
-    mConfigurationStateTable.Start();
-
     CMN_LOG_CLASS_INIT_VERBOSE << "Configure: using " << filename << std::endl;
-    cmnXMLPath config;
-    config.SetInputSource(filename);
-    mNumberOfActiveJoints = 0;
-    bool hasInactiveJoints = false;
-
-    // check type, interface and number of joints
-    std::string type, interface;
-    config.GetXMLValue("/controller", "@type", type, "");
-    config.GetXMLValue("/controller", "@interface", interface, "");
-    int numberOfJoints;
-    config.GetXMLValue("/controller", "@numofjoints", numberOfJoints, -1);
-    if (type != "PID") {
-        CMN_LOG_CLASS_INIT_ERROR << "Configure: wrong controller type" << std::endl;
-        mConfigurationStateTable.Advance();
-        return;
-    } else if (interface != "JointTorqueInterface") {
-        CMN_LOG_CLASS_INIT_ERROR << "Configure: wrong interface. Require JointTorqueInterface" << std::endl;
-        mConfigurationStateTable.Advance();
-        return;
-    } else if (numberOfJoints < 0) {
-        CMN_LOG_CLASS_INIT_ERROR << "Configure: invalid number of joints" << std::endl;
-        mConfigurationStateTable.Advance();
+    osaPIDConfiguration configuration;
+
+    // compiled file if any and up to date, see SetConfigurationCache
+    std::string compiledFile;
+    unsigned long long xmlHash = 0;
+    if (!mConfigurationCache.empty()
+        && osaPIDConfiguration::FileHash(filename, xmlHash)) {
+        // XML files with the same name in different directories
+        // share the cache, the hash of the content keeps them apart
+        const size_t separator = filename.find_last_of("/\\");
+        std::stringstream name;
+        name << mConfigurationCache << "/"
+             << ((separator == std::string::npos) ? filename : filename.substr(separator + 1))
+             << "." << std::hex << std::setw(16) << std::setfill('0') << xmlHash
+             << ".compiled";
+        compiledFile = name.str();
+        if (configuration.LoadCompiled(compiledFile, xmlHash)) {
+            CMN_LOG_CLASS_INIT_VERBOSE << "Configure: using compiled file " << compiledFile << std::endl;
+            ApplyConfiguration(configuration);
+            return;
+        }
+    }
+
+    if (!configuration.LoadXML(filename)) {
+        CMN_LOG_CLASS_INIT_ERROR << "Configure: failed to load " << filename << std::endl;
         return;
     }
-    mNumberOfJoints = static_cast<size_t>(numberOfJoints);
+    // only cache configurations fully applied
+    if (ApplyConfiguration(configuration) && !compiledFile.empty()) {
+        configuration.SaveCompiled(compiledFile, xmlHash);
+    }
+}
+
+bool mtsPID::ApplyConfiguration(const osaPIDConfiguration & configuration)
+{
+    // history depth, tables can only be resized before they're used
+    const int stateTableSize = (configuration.StateTableSize != 0)
+        ? configuration.StateTableSize : static_cast<int>(StateTable.GetHistoryLength());
+    const int configurationStateTableSize = (configuration.ConfigurationStateTableSize != 0)
+        ? configuration.ConfigurationStateTableSize : static_cast<int>(mConfigurationStateTable.GetHistoryLength());
+    if (!StateTable.SetSize(stateTableSize)
+        || !mConfigurationStateTable.SetSize(configurationStateTableSize)) {
+        CMN_LOG_CLASS_INIT_ERROR << "ApplyConfiguration: failed to resize state tables" << std::endl;
+    }
+
+    mConfigurationStateTable.Start();
+    mNumberOfJoints = configuration.Joints.size();
+    mNumberOfActiveJoints = configuration.NumberOfActiveJoints;
 
     // set dynamic var size
     mJointType.SetSize(mNumberOfJoints);
+    for (size_t i = 0; i < mNumberOfJoints; i++) {
+        mJointType.at(i) = configuration.Joints[i].Type;
+    }
 
     // feedback
     mPositionMeasure.Position().SetSize(mNumberOfJoints, 0.0);
@@ -194,50 +264,7 @@ void mtsPID::Configure(const std::string & filename)
     mEffortPIDCommand.ForceTorque().SetSize(mNumberOfJoints, 0.0);
     mEffortUserCommand.ForceTorque().SetSize(mNumberOfJoints, 0.0);
     mVelocityMeasure.Velocity().SetSize(mNumberOfJoints, 0.0);
-    mPositionMeasurePrevious.Position().SetSize(mNumberOfJoints, 0.0);
-
-    // read data from xml file
-    char context[64];
-
-    // first loop to find inactive joints
-    for (int i = 0; i < numberOfJoints; i++) {
-        // joint
-        sprintf(context, "controller/joints/joint[%d]", i + 1);
-
-        // type
-        std::string type;
-        config.GetXMLValue(context, "@type", type);
-        if (type == "Revolute") {
-            mJointType.at(i) = PRM_REVOLUTE;
-        } else if (type == "Prismatic") {
-            mJointType.at(i) = PRM_PRISMATIC;
-        } else if (type == "Inactive") {
-            mJointType.at(i) = PRM_INACTIVE;
-        } else {
-            CMN_LOG_CLASS_INIT_ERROR << "Configure: joint " << i << " in file: "
-                                     << filename
-                                     << " needs a \"type\", either \"Revolute\" or \"Prismatic\""
-                                     << std::endl;
-            mConfigurationStateTable.Advance();
-            return;
-        }
-
-        // make sure we update the number of active joints
-        if (mJointType.at(i) == PRM_INACTIVE) {
-            hasInactiveJoints = true;
-        } else {
-            // we found an inactive joint after an active one, this is not supported
-            if (hasInactiveJoints) {
-                CMN_LOG_CLASS_INIT_ERROR << "Configure: joint " << i << " in file: "
-                                         << filename
-                                         << " has is not \"Inactive\" but is defined after an \"Inactive\" joint, this is not supported"
-                                         << std::endl;
-                mConfigurationStateTable.Advance();
-                return;
-            }
-            mNumberOfActiveJoints++;
-        }
-    }
+    mVelocityEstimator.SetSize(mNumberOfJoints);
 
     // size all vectors specific to active joints
     mGains.Kp.SetSize(mNumberOfActiveJoints);
@@ -248,6 +275,12 @@ void mtsPID::Configure(const std::string & filename)
     mPositionUpperLimit.SetSize(mNumberOfActiveJoints, 0.0);
     mEffortLowerLimit.SetSize(mNumberOfActiveJoints, 0.0);
     mEffortUpperLimit.SetSize(mNumberOfActiveJoints, 0.0);
+    mVelocityFeedForward.SetSize(mNumberOfActiveJoints, 0.0);
+    mAccelerationFeedForward.SetSize(mNumberOfActiveJoints, 0.0);
+    mCommandAcceleration.SetSize(mNumberOfActiveJoints, 0.0);
+    mFeedForwardEffort.SetSize(mNumberOfActiveJoints, 0.0);
+    mModelEffort.SetSize(mNumberOfActiveJoints, 0.0);
+    mCommandVelocityTime = 0.0;
     mPositionLimitFlag.SetSize(mNumberOfActiveJoints);
     mPositionLimitFlag.SetAll(false);
     mPositionLimitFlagPrevious.ForceAssign(mPositionLimitFlag);
@@ -255,8 +288,9 @@ void mtsPID::Configure(const std::string & filename)
     mJointsEnabled.SetAll(true);
 
     // errors
-    mError.SetSize(mNumberOfActiveJoints);
-    mIError.SetSize(mNumberOfActiveJoints);
+    mKernelLocal.SetSize(mNumberOfActiveJoints);
+    mKernel = &mKernelLocal;
+    mKernelFirst = 0;
     ResetController();
 
     mIErrorLimitMin.SetSize(mNumberOfActiveJoints, cmnTypeTraits<double>::MinNegativeValue());
@@ -266,6 +300,14 @@ void mtsPID::Configure(const std::string & filename)
     mIErrorForgetFactor.SetSize(mNumberOfActiveJoints);
     mIErrorForgetFactor.SetAll(1.0);
 
+    // default: no filtering on derivative term
+    mDerivativeFilter.SetSize(mNumberOfActiveJoints);
+    mDerivativeVelocity.SetSize(mNumberOfActiveJoints, 0.0);
+
+    // default: no limits, goals are rejected
+    mTrajectoryGenerator.SetSize(mNumberOfActiveJoints);
+    mTrajectoryGoal.SetSize(mNumberOfActiveJoints, 0.0);
+
     // default: use regular PID
     mNonLinear.SetSize(mNumberOfActiveJoints);
     mNonLinear.SetAll(0.0);
@@ -281,53 +323,122 @@ void mtsPID::Configure(const std::string & filename)
     mTrackingErrorEnabled = false;
     mTrackingErrorTolerances.SetSize(mNumberOfActiveJoints, 0.0);
     mTrackingErrorFlag.SetSize(mNumberOfActiveJoints, false);
-    mPreviousTrackingErrorFlag.ForceAssign(mTrackingErrorFlag);
-
-    // loop to get configuration data except type
-    for (int i = 0; i < mNumberOfActiveJoints; i++) {
-        // joint
-        sprintf(context, "controller/joints/joint[%d]", i + 1);
-
-        // name
-        std::string name;
-        config.GetXMLValue(context, "@name", name);
-        // names in joint states
-        mStateJointMeasure.Name().resize(mNumberOfActiveJoints);
-        mStateJointCommand.Name().resize(mNumberOfActiveJoints);
-        mStateJointMeasure.Name().at(i) = name;
-        mStateJointCommand.Name().at(i) = name;
+    mTrackingErrorSnapshot.SetSize(mNumberOfActiveJoints, 0.0);
+
+    // gains bundle, all buffers allocated now
+    mGainsBundle.SetSize(NUMBER_OF_GAINS_ROWS, mNumberOfActiveJoints, 0.0);
+    mGainsUpdate.SetAll(mGainsBundle);
+
+    // configuration data except type
+    for (size_t i = 0; i < mNumberOfActiveJoints; i++) {
+        const osaPIDConfiguration::Joint & joint = configuration.Joints[i];
+
+        // names for joint states
+        mJointNames.resize(mNumberOfActiveJoints);
+        mJointNames.at(i) = joint.Name;
 
         // pid
-        config.GetXMLValue(context, "pid/@PGain", mGains.Kp.at(i));
-        config.GetXMLValue(context, "pid/@DGain", mGains.Kd.at(i));
-        config.GetXMLValue(context, "pid/@IGain", mGains.Ki.at(i));
-        config.GetXMLValue(context, "pid/@OffsetTorque", mGains.Offset.at(i));
-        config.GetXMLValue(context, "pid/@Forget", mIErrorForgetFactor.at(i));
-        config.GetXMLValue(context, "pid/@Nonlinear", mNonLinear.at(i));
+        mGains.Kp.at(i) = joint.PGain;
+        mGains.Kd.at(i) = joint.DGain;
+        mGains.Ki.at(i) = joint.IGain;
+        mGains.Offset.at(i) = joint.OffsetTorque;
+        mIErrorForgetFactor.at(i) = joint.Forget;
+        mNonLinear.at(i) = joint.Nonlinear;
+        mVelocityFeedForward.at(i) = joint.VelocityFeedForward;
+        mAccelerationFeedForward.at(i) = joint.AccelerationFeedForward;
 
         // limit
-        config.GetXMLValue(context, "limit/@MinILimit", mIErrorLimitMin.at(i));
-        config.GetXMLValue(context, "limit/@MaxILimit", mIErrorLimitMax.at(i));
-        config.GetXMLValue(context, "limit/@ErrorLimit", mTrackingErrorTolerances.at(i));
-        config.GetXMLValue(context, "limit/@Deadband", mDeadBand.at(i));
+        mIErrorLimitMin.at(i) = joint.MinILimit;
+        mIErrorLimitMax.at(i) = joint.MaxILimit;
+        mTrackingErrorTolerances.at(i) = joint.ErrorLimit;
+        mDeadBand.at(i) = joint.Deadband;
+
+        // velocity estimation, only used if IO doesn't provide velocities
+        bool filterOk = true;
+        switch (joint.VelocityFilter) {
+        case osaVelocityEstimator::FINITE_DIFFERENCE:
+            mVelocityEstimator.SetFiniteDifference(i);
+            break;
+        case osaVelocityEstimator::LOW_PASS:
+            mVelocityEstimator.SetLowPass(i, joint.VelocityCutoff);
+            break;
+        case osaVelocityEstimator::SAVITZKY_GOLAY:
+            filterOk = mVelocityEstimator.SetSavitzkyGolay(i, joint.VelocityWindow, joint.VelocityOrder);
+            break;
+        case osaVelocityEstimator::ADAPTIVE_WINDOW:
+            filterOk = mVelocityEstimator.SetAdaptiveWindow(i, joint.VelocityWindow, joint.VelocityNoiseLevel);
+            break;
+        default:
+            filterOk = false;
+            break;
+        }
+        if (!filterOk) {
+            CMN_LOG_CLASS_INIT_ERROR << "ApplyConfiguration: joint " << i
+                                     << " has an invalid velocity filter, Window or Order" << std::endl;
+            mConfigurationStateTable.Advance();
+            return false;
+        }
+
+        // filter for derivative term, coefficients depend on period
+        switch (joint.DerivativeFilter) {
+        case osaDerivativeFilter::NONE:
+            mDerivativeFilter.SetNone(i);
+            break;
+        case osaDerivativeFilter::BUTTERWORTH:
+            filterOk = mDerivativeFilter.SetButterworth(i, joint.DerivativeCutoff, this->GetPeriodicity());
+            break;
+        case osaDerivativeFilter::TUSTIN:
+            filterOk = mDerivativeFilter.SetTustin(i, joint.DerivativeCutoff, this->GetPeriodicity());
+            break;
+        case osaDerivativeFilter::OBSERVER:
+            filterOk = mDerivativeFilter.SetObserver(i, joint.DerivativeProcessNoise,
+                                                     joint.DerivativeMeasurementNoise,
+                                                     this->GetPeriodicity());
+            break;
+        default:
+            filterOk = false;
+            break;
+        }
+        if (!filterOk) {
+            CMN_LOG_CLASS_INIT_ERROR << "ApplyConfiguration: joint " << i
+                                     << " has an invalid derivative filter, \"Filter\" must be \"None\", \"Butterworth\" (Cutoff), \"Tustin\" (Cutoff) or \"Observer\" (ProcessNoise, MeasurementNoise)"
+                                     << std::endl;
+            mConfigurationStateTable.Advance();
+            return false;
+        }
+
+        // trajectory limits for goals, all or none
+        if (joint.HasTrajectoryLimits
+            && !mTrajectoryGenerator.SetLimits(i, joint.MaxVelocity, joint.MaxAcceleration, joint.MaxJerk)) {
+            CMN_LOG_CLASS_INIT_ERROR << "ApplyConfiguration: joint " << i
+                                     << " has invalid trajectory limits, \"MaxVelocity\", \"MaxAcceleration\" and \"MaxJerk\" must be positive"
+                                     << std::endl;
+            mConfigurationStateTable.Advance();
+            return false;
+        }
 
         // joint limit
-        mCheckPositionLimit = true;
-        std::string tmpUnits;
-        bool ret = false;
-        ret = config.GetXMLValue(context, "pos/@Units", tmpUnits);
-        if (ret) {
-            config.GetXMLValue(context, "pos/@LowerLimit", mPositionLowerLimit.at(i));
-            config.GetXMLValue(context, "pos/@UpperLimit", mPositionUpperLimit.at(i));
-            if (tmpUnits == "deg") {
-                mPositionLowerLimit.at(i) *= cmnPI_180;
-                mPositionUpperLimit.at(i) *= cmnPI_180;
-            } else if (tmpUnits == "mm") {
-                mPositionLowerLimit.at(i) *= cmn_mm;
-                mPositionUpperLimit.at(i) *= cmn_mm;
-            }
-        } else {
-            mCheckPositionLimit = false;
+        mCheckPositionLimit = joint.HasPositionLimits;
+        mHasPositionLimits = joint.HasPositionLimits;
+        mPositionLowerLimit.at(i) = joint.PositionLowerLimit;
+        mPositionUpperLimit.at(i) = joint.PositionUpperLimit;
+    }
+
+    // simulated plant, only used if SetSimulatedPlant is called
+    mSimulatedPlant.SetSize(mNumberOfActiveJoints);
+    mSimulatedPlant.SetSubStep(configuration.SimulationSubStep);
+    // a late iteration shouldn't run thousands of sub steps
+    if (this->GetPeriodicity() > 0.0) {
+        mSimulatedPlant.SetMaximumDuration(10.0 * this->GetPeriodicity());
+    }
+    for (size_t i = 0; i < mNumberOfActiveJoints; i++) {
+        const osaPIDConfiguration::Joint & joint = configuration.Joints[i];
+        if (!mSimulatedPlant.SetJoint(i, joint.PlantMass, joint.PlantDamping,
+                                      joint.PlantFriction, joint.PlantBacklash)) {
+            CMN_LOG_CLASS_INIT_ERROR << "ApplyConfiguration: joint " << i
+                                     << " has invalid plant parameters" << std::endl;
+            mConfigurationStateTable.Advance();
+            return false;
         }
     }
 
@@ -349,21 +460,251 @@ void mtsPID::Configure(const std::string & filename)
                                << "elimit: " << mTrackingErrorTolerances << std::endl
                                << "forget: " << mIErrorForgetFactor << std::endl;
 
+    UpdateKernelConfiguration();
+
     mConfigurationStateTable.Advance();
 
     mStateJointMeasure.Position().SetSize(mNumberOfActiveJoints, 0.0);
     mStateJointMeasure.Velocity().SetSize(mNumberOfActiveJoints, 0.0);
     mStateJointMeasure.Effort().SetSize(mNumberOfActiveJoints, 0.0);
     mStateJointCommand.Position().SetSize(mNumberOfActiveJoints, 0.0);
-    mStateJointCommand.Velocity().SetSize(0); // we don't support desired velocity
+    mStateJointCommand.Velocity().SetSize(mNumberOfActiveJoints, 0.0);
     mStateJointCommand.Effort().SetSize(mNumberOfActiveJoints, 0.0);
 
+    // gain scheduling, joints without table use fixed gains
+    mGainSchedule.SetSize(mNumberOfActiveJoints);
+    mGainScheduleVariable.SetSize(mNumberOfActiveJoints, 0.0);
+    osaGainSchedule::Table gainScheduleTable;
+    if (!configuration.GainSchedule(gainScheduleTable)) {
+        CMN_LOG_CLASS_INIT_ERROR << "ApplyConfiguration: invalid gain schedule" << std::endl;
+        return false;
+    }
+    mGainSchedule.SetTable(gainScheduleTable);
+
+    // interpolation between setpoints
+    mInterpolator.Configure(mNumberOfActiveJoints, configuration.Interpolation,
+                            this->GetPeriodicity(), configuration.InterpolationMaxInterval);
+
+    // telemetry, buffer has to hold data until the writer thread wakes up
+    ConfigureTelemetry(configuration.TelemetryBufferDuration);
+
+    // events from the control loop, at most one per type per interval
+    mEvents.Configure(NUMBER_OF_EVENTS, EVENT_VECTORS * mNumberOfActiveJoints, 32,
+                      configuration.EventMinimumInterval);
+
     // now that we know the sizes of vectors, create interfaces
     this->SetupInterfaces();
+
+    std::stringstream footprint;
+    mFootprint.ToStream(footprint);
+    CMN_LOG_CLASS_INIT_VERBOSE << "ApplyConfiguration: state tables use " << mFootprint.Bytes()
+                               << " bytes" << std::endl << footprint.str();
+    return true;
+}
+
+void mtsPID::LoadGainSchedule(const std::string & filename)
+{
+    // not queued, one writer at a time
+    mGainScheduleMutex.Lock();
+    osaPIDConfiguration schedule;
+    schedule.NumberOfActiveJoints = mNumberOfActiveJoints;
+    schedule.Joints.resize(mNumberOfActiveJoints);
+    osaGainSchedule::Table table;
+    const bool valid = schedule.LoadGainScheduleXML(filename)
+        && schedule.GainSchedule(table) && mGainSchedule.SetTable(table);
+    mGainScheduleMutex.Unlock();
+    if (valid) {
+        SendStatus(this->GetName() + ": loaded gain schedule from " + filename);
+    } else {
+        SendError(this->GetName() + ": failed to load gain schedule from " + filename);
+    }
+}
+
+void mtsPID::SetGainScheduleVariable(const vctDoubleVec & variable)
+{
+    if (variable.size() != mNumberOfActiveJoints) {
+        CMN_LOG_CLASS_RUN_ERROR << "SetGainScheduleVariable: size mismatch" << std::endl;
+        return;
+    }
+    mGainScheduleVariable.Assign(variable);
+}
+
+void mtsPID::UpdateKernelConfiguration(void)
+{
+    KernelField(osaPIDKernel::KP).Assign(mGains.Kp);
+    KernelField(osaPIDKernel::KI).Assign(mGains.Ki);
+    KernelField(osaPIDKernel::KD).Assign(mGains.Kd);
+    KernelField(osaPIDKernel::DEADBAND).Assign(mDeadBand);
+    KernelField(osaPIDKernel::IERROR_LIMIT_MIN).Assign(mIErrorLimitMin);
+    KernelField(osaPIDKernel::IERROR_LIMIT_MAX).Assign(mIErrorLimitMax);
+    KernelField(osaPIDKernel::IERROR_FORGET_FACTOR).Assign(mIErrorForgetFactor);
+    KernelField(osaPIDKernel::NONLINEAR).Assign(mNonLinear);
+    KernelField(osaPIDKernel::EFFORT_LOWER_LIMIT).Assign(mEffortLowerLimit);
+    KernelField(osaPIDKernel::EFFORT_UPPER_LIMIT).Assign(mEffortUpperLimit);
+    KernelField(osaPIDKernel::TRACKING_ERROR_TOLERANCE).Assign(mTrackingErrorTolerances);
+    KernelField(osaPIDKernel::VELOCITY_FEEDFORWARD).Assign(mVelocityFeedForward);
+    KernelField(osaPIDKernel::ACCELERATION_FEEDFORWARD).Assign(mAccelerationFeedForward);
+
+    // keep bundle in sync for GetGains
+    mGainsBundle.Row(GAINS_KP).Assign(mGains.Kp);
+    mGainsBundle.Row(GAINS_KD).Assign(mGains.Kd);
+    mGainsBundle.Row(GAINS_KI).Assign(mGains.Ki);
+    mGainsBundle.Row(GAINS_IERROR_LIMIT_MIN).Assign(mIErrorLimitMin);
+    mGainsBundle.Row(GAINS_IERROR_LIMIT_MAX).Assign(mIErrorLimitMax);
+    mGainsBundle.Row(GAINS_POSITION_LOWER_LIMIT).Assign(mPositionLowerLimit);
+    mGainsBundle.Row(GAINS_POSITION_UPPER_LIMIT).Assign(mPositionUpperLimit);
+    mGainsBundle.Row(GAINS_EFFORT_LOWER_LIMIT).Assign(mEffortLowerLimit);
+    mGainsBundle.Row(GAINS_EFFORT_UPPER_LIMIT).Assign(mEffortUpperLimit);
+    mGainsBundle.Row(GAINS_TRACKING_ERROR_TOLERANCE).Assign(mTrackingErrorTolerances);
+    mGainsBundle.Row(GAINS_DEADBAND).Assign(mDeadBand);
+    mGainsBundle.Row(GAINS_IERROR_FORGET_FACTOR).Assign(mIErrorForgetFactor);
+    mGainsBundle.Row(GAINS_NONLINEAR).Assign(mNonLinear);
+    mGainsBundle.Row(GAINS_OFFSET).Assign(mGains.Offset);
+    mGainsBundle.Row(GAINS_VELOCITY_FEEDFORWARD).Assign(mVelocityFeedForward);
+    mGainsBundle.Row(GAINS_ACCELERATION_FEEDFORWARD).Assign(mAccelerationFeedForward);
+}
+
+void mtsPID::SetGains(const vctDoubleMat & gains)
+{
+    PublishGains(gains);
+}
+
+bool mtsPID::PublishGains(const vctDoubleMat & gains)
+{
+    if ((gains.rows() != NUMBER_OF_GAINS_ROWS)
+        || (gains.cols() != mNumberOfActiveJoints)) {
+        SendError(this->GetName() + ": SetGains, size mismatch");
+        return false;
+    }
+    for (size_t index = 0; index < mNumberOfActiveJoints; ++index) {
+        if ((gains.Element(GAINS_IERROR_LIMIT_MIN, index) > gains.Element(GAINS_IERROR_LIMIT_MAX, index))
+            || (gains.Element(GAINS_POSITION_LOWER_LIMIT, index) > gains.Element(GAINS_POSITION_UPPER_LIMIT, index))
+            || (gains.Element(GAINS_EFFORT_LOWER_LIMIT, index) > gains.Element(GAINS_EFFORT_UPPER_LIMIT, index))
+            || (gains.Element(GAINS_TRACKING_ERROR_TOLERANCE, index) < 0.0)
+            || (gains.Element(GAINS_DEADBAND, index) < 0.0)
+            || (gains.Element(GAINS_IERROR_FORGET_FACTOR, index) < 0.0)
+            || (gains.Element(GAINS_IERROR_FORGET_FACTOR, index) > 1.0)) {
+            SendError(this->GetName() + ": SetGains, invalid limits for joint " + mJointNames.at(index));
+            return false;
+        }
+    }
+    mGainsMutex.Lock();
+    mGainsUpdate.Back().Assign(gains);
+    mGainsUpdate.Publish();
+    mGainsMutex.Unlock();
+    return true;
+}
+
+void mtsPID::ReloadConfiguration(const std::string & filename)
+{
+    osaPIDConfiguration configuration;
+    if (!configuration.LoadXML(filename)) {
+        SendError(this->GetName() + ": ReloadConfiguration, failed to load " + filename);
+        return;
+    }
+    // vectors are not resized, joints must match
+    bool sameJoints = (configuration.Joints.size() == mNumberOfJoints)
+        && (configuration.NumberOfActiveJoints == mNumberOfActiveJoints);
+    for (size_t i = 0; sameJoints && (i < mNumberOfJoints); ++i) {
+        sameJoints = (configuration.Joints[i].Type == mJointType.at(i));
+    }
+    if (!sameJoints) {
+        SendError(this->GetName() + ": ReloadConfiguration, number of joints or joint types in "
+                              + filename + " don't match current configuration");
+        return;
+    }
+    // missing limits would default to 0 and clamp all commands
+    bool sameLimits = true;
+    for (size_t i = 0; sameLimits && (i < mNumberOfActiveJoints); ++i) {
+        sameLimits = (configuration.Joints[i].HasPositionLimits == mHasPositionLimits);
+    }
+    if (!sameLimits) {
+        SendError(this->GetName() + ": ReloadConfiguration, position limits in "
+                  + filename + " must be defined for all joints if and only if they are in the current configuration");
+        return;
+    }
+
+    // start from the latest bundle for values not in the file (effort limits)
+    mtsGenericObjectProxy<vctDoubleMat> current;
+    if (!mGainsBundleAccessor || !mGainsBundleAccessor->GetLatest(current)) {
+        SendError(this->GetName() + ": ReloadConfiguration, can't read current gains");
+        return;
+    }
+    vctDoubleMat gains(current.GetData());
+    for (size_t i = 0; i < mNumberOfActiveJoints; ++i) {
+        const osaPIDConfiguration::Joint & joint = configuration.Joints[i];
+        gains.Element(GAINS_KP, i) = joint.PGain;
+        gains.Element(GAINS_KD, i) = joint.DGain;
+        gains.Element(GAINS_KI, i) = joint.IGain;
+        gains.Element(GAINS_IERROR_LIMIT_MIN, i) = joint.MinILimit;
+        gains.Element(GAINS_IERROR_LIMIT_MAX, i) = joint.MaxILimit;
+        if (mHasPositionLimits) {
+            gains.Element(GAINS_POSITION_LOWER_LIMIT, i) = joint.PositionLowerLimit;
+            gains.Element(GAINS_POSITION_UPPER_LIMIT, i) = joint.PositionUpperLimit;
+        }
+        gains.Element(GAINS_TRACKING_ERROR_TOLERANCE, i) = joint.ErrorLimit;
+        // same conversion as Configure
+        gains.Element(GAINS_DEADBAND, i) = joint.Deadband * cmnPI_180;
+        gains.Element(GAINS_IERROR_FORGET_FACTOR, i) = joint.Forget;
+        gains.Element(GAINS_NONLINEAR, i) = joint.Nonlinear;
+        gains.Element(GAINS_OFFSET, i) = joint.OffsetTorque;
+        gains.Element(GAINS_VELOCITY_FEEDFORWARD, i) = joint.VelocityFeedForward;
+        gains.Element(GAINS_ACCELERATION_FEEDFORWARD, i) = joint.AccelerationFeedForward;
+    }
+    if (PublishGains(gains)) {
+        SendStatus(this->GetName() + ": reloaded configuration from " + filename);
+    }
+}
+
+void mtsPID::ApplyGains(void)
+{
+    const vctDoubleMat & gains = mGainsUpdate.Front();
+    mConfigurationStateTable.Start();
+    mGains.Kp.Assign(gains.Row(GAINS_KP));
+    mGains.Kd.Assign(gains.Row(GAINS_KD));
+    mGains.Ki.Assign(gains.Row(GAINS_KI));
+    mIErrorLimitMin.Assign(gains.Row(GAINS_IERROR_LIMIT_MIN));
+    mIErrorLimitMax.Assign(gains.Row(GAINS_IERROR_LIMIT_MAX));
+    mPositionLowerLimit.Assign(gains.Row(GAINS_POSITION_LOWER_LIMIT));
+    mPositionUpperLimit.Assign(gains.Row(GAINS_POSITION_UPPER_LIMIT));
+    mEffortLowerLimit.Assign(gains.Row(GAINS_EFFORT_LOWER_LIMIT));
+    mEffortUpperLimit.Assign(gains.Row(GAINS_EFFORT_UPPER_LIMIT));
+    mTrackingErrorTolerances.Assign(gains.Row(GAINS_TRACKING_ERROR_TOLERANCE));
+    mDeadBand.Assign(gains.Row(GAINS_DEADBAND));
+    mIErrorForgetFactor.Assign(gains.Row(GAINS_IERROR_FORGET_FACTOR));
+    mNonLinear.Assign(gains.Row(GAINS_NONLINEAR));
+    mGains.Offset.Assign(gains.Row(GAINS_OFFSET));
+    mVelocityFeedForward.Assign(gains.Row(GAINS_VELOCITY_FEEDFORWARD));
+    mAccelerationFeedForward.Assign(gains.Row(GAINS_ACCELERATION_FEEDFORWARD));
+    UpdateKernelConfiguration();
+    mConfigurationStateTable.Advance();
+
+    mApplyEffortLimit = mEffortLowerLimit.Any() && mEffortUpperLimit.Any();
+}
+
+void mtsPID::UseKernel(osaPIDKernel & kernel, const size_t first)
+{
+    if ((first + mNumberOfActiveJoints) > kernel.size()) {
+        CMN_LOG_CLASS_INIT_ERROR << "UseKernel: kernel is too small for "
+                                 << mNumberOfActiveJoints << " joints starting at "
+                                 << first << std::endl;
+        return;
+    }
+    // copy all fields, including state, to new kernel
+    for (size_t field = 0; field < osaPIDKernel::NUMBER_OF_FIELDS; ++field) {
+        const osaPIDKernel::FieldType fieldType = static_cast<osaPIDKernel::FieldType>(field);
+        kernel.Field(fieldType, first, mNumberOfActiveJoints).Assign(KernelField(fieldType));
+    }
+    mKernel = &kernel;
+    mKernelFirst = first;
 }
 
 void mtsPID::Startup(void)
 {
+    mLoopTiming.Configure(this->GetPeriodicity());
+    // no thread when stepped by a harness, see SetVirtualClock
+    mEvents.Start(&mEventHandler, mVirtualTime == 0);
+
     // get joint type from IO and check against values from PID config file
     if (!mIsSimulated) {
         mtsExecutionResult result;
@@ -390,181 +731,169 @@ void mtsPID::Startup(void)
 
 void mtsPID::Run(void)
 {
-    ProcessQueuedEvents();
-    ProcessQueuedCommands();
-
-    // get data from IO if not in simulated mode
-    GetIOData(true); // compute velocity if needed
-
-    // initialize variables
-    bool anyTrackingError = false;
+    // evaluated by the owner of the kernel, see UseKernel
+    if (mKernel != &mKernelLocal) {
+        return;
+    }
+    RunBeforeKernel();
     bool newTrackingError = false;
+    mKernel->Evaluate(mKernelFirst, mNumberOfActiveJoints, newTrackingError);
+    RunAfterKernel();
+}
 
-    // loop on all joints
-    vctBoolVec::const_iterator enabled = mJointsEnabled.begin();
-    vctDoubleVec::const_iterator measurePosition = mStateJointMeasure.Position().begin();
-    vctDoubleVec::const_iterator measureVelocity = mStateJointMeasure.Velocity().begin();
-    vctDoubleVec::iterator commandPosition = mStateJointCommand.Position().begin();
-    vctDoubleVec::iterator commandEffort = mStateJointCommand.Effort().begin();
-    vctBoolVec::const_iterator effortMode = mEffortMode.begin();
-    vctDoubleVec::const_iterator effortUserCommand = mEffortUserCommand.ForceTorque().begin();
-    vctDoubleVec::iterator error = mError.begin();
-    vctDoubleVec::const_iterator deadBand = mDeadBand.begin();
-    vctDoubleVec::const_iterator tolerance = mTrackingErrorTolerances.begin();
-    vctBoolVec::iterator limitFlag = mPositionLimitFlag.begin();
-    vctBoolVec::iterator trackingErrorFlag = mTrackingErrorFlag.begin();
-    vctBoolVec::iterator previousTrackingErrorFlag = mPreviousTrackingErrorFlag.begin();
-    vctDoubleVec::iterator iError = mIError.begin();
-    vctDoubleVec::const_iterator iErrorForgetFactor = mIErrorForgetFactor.begin();
-    vctDoubleVec::const_iterator iErrorLimitMin = mIErrorLimitMin.begin();
-    vctDoubleVec::const_iterator iErrorLimitMax = mIErrorLimitMax.begin();
-    vctDoubleVec::const_iterator kP = mGains.Kp.begin();
-    vctDoubleVec::const_iterator kI = mGains.Ki.begin();
-    vctDoubleVec::const_iterator kD = mGains.Kd.begin();
-    vctDoubleVec::const_iterator offset = mGains.Offset.begin();
-    vctDoubleVec::const_iterator nonLinear = mNonLinear.begin();
-    vctDoubleVec::const_iterator effortLowerLimit = mEffortLowerLimit.begin();
-    vctDoubleVec::const_iterator effortUpperLimit = mEffortUpperLimit.begin();
-
-    // loop on all active joints using iterators
-    for (size_t i = 0;
-         i < mNumberOfActiveJoints;
-         ++i,
-             // make sure you increment all iterators declared above!
-             ++enabled,
-             ++measurePosition,
-             ++measureVelocity,
-             ++commandPosition,
-             ++commandEffort,
-             ++effortMode,
-             ++effortUserCommand,
-             ++error,
-             ++deadBand,
-             ++tolerance,
-             ++limitFlag,
-             ++trackingErrorFlag,
-             ++previousTrackingErrorFlag,
-             ++iError,
-             ++iErrorForgetFactor,
-             ++iErrorLimitMin,
-             ++iErrorLimitMax,
-             ++kP,
-             ++kI,
-             ++kD,
-             ++offset,
-             ++nonLinear,
-             ++effortLowerLimit,
-             ++effortUpperLimit
-         ) {
-
-        // first check if the controller and this joint is enabled
-        if (!mEnabled || !(*enabled)) {
-            *commandEffort = 0.0;
-            *commandPosition = *measurePosition;
-        } else {
-            // the PID controller is enabled and this joint is actively controlled
-            // check the mode, i.e. position or effort pass-through
-            if (*effortMode) {
-                *commandEffort = *effortUserCommand;
-                *commandPosition = *measurePosition;
-            } else {
-                // PID mode
-                *error = *commandPosition - *measurePosition;
-                // apply dead band
-                if ((*error <= *deadBand) && (*error >= -(*deadBand))) {
-                    *error = 0.0;
-                }
-                // check for tracking errors
-                if (mTrackingErrorEnabled) {
-                    double errorAbsolute = fabs(*error);
-                    // trigger error if the error is too high
-                    // AND the last request was not outside joint limit
-                    if ((errorAbsolute > *tolerance) && !(*limitFlag)) {
-                        anyTrackingError = true;
-                        *trackingErrorFlag = true;
-                        if (*trackingErrorFlag != *previousTrackingErrorFlag) {
-                            newTrackingError = true;
-                        }
-                    } else {
-                        *trackingErrorFlag = false;
-                    }
-                    *previousTrackingErrorFlag = *trackingErrorFlag;
-                } // end of tracking error
-
-                // compute error derivative
-                double dError =  -1.0 * (*measureVelocity);
-
-                // compute error integral
-                *iError *= *iErrorForgetFactor;
-                *iError += *error;
-                if (*iError > *iErrorLimitMax) {
-                    *iError = *iErrorLimitMax;
-                }
-                else if (*iError < *iErrorLimitMin) {
-                    *iError = *iErrorLimitMin;
-                }
+void mtsPID::RunBeforeKernel(void)
+{
+    mLoopTiming.BeginTick();
+    ProcessQueuedEvents();
+    ProcessQueuedCommands();
 
-                // compute effort
-                *commandEffort =
-                    *kP * (*error) + *kD * dError + *kI * (*iError);
+    // gains and limits from SetGains, all applied on this tick
+    if (mGainsUpdate.Update()) {
+        ApplyGains();
+    }
 
-                // nonlinear control mode
-                if (*nonLinear > 0.0) {
-                    const double absError = fabs(*error);
-                    if (absError < *nonLinear) {
-                        *commandEffort *= (absError / *nonLinear);
-                    }
-                }
+    // new gain schedule, restore fixed gains for joints no longer scheduled
+    if (mGainSchedule.Update()) {
+        KernelField(osaPIDKernel::KP).Assign(mGains.Kp);
+        KernelField(osaPIDKernel::KI).Assign(mGains.Ki);
+        KernelField(osaPIDKernel::KD).Assign(mGains.Kd);
+    }
 
-                // add constant offsets in PID mode only and after non-linear scaling
-                *commandEffort += *offset;
+    // get data from IO if not in simulated mode
+    mLoopTiming.BeginIO();
+    GetIOData(true); // compute velocity if needed
+    mLoopTiming.EndIO();
 
-            } // end of PID mode
+    // copy modes, offsets and inputs to kernel
+    if (mEnabled) {
+        KernelField(osaPIDKernel::ENABLED).Assign(mJointsEnabled);
+    } else {
+        KernelField(osaPIDKernel::ENABLED).SetAll(0.0);
+    }
+    KernelField(osaPIDKernel::EFFORT_MODE).Assign(mEffortMode);
+    KernelField(osaPIDKernel::TRACKING_ERROR_ENABLED).SetAll(mTrackingErrorEnabled ? 1.0 : 0.0);
+    KernelField(osaPIDKernel::APPLY_EFFORT_LIMIT).SetAll(mApplyEffortLimit ? 1.0 : 0.0);
+    KernelField(osaPIDKernel::POSITION_LIMIT).Assign(mPositionLimitFlag);
+    KernelField(osaPIDKernel::OFFSET).Assign(mGains.Offset);
+    KernelField(osaPIDKernel::MEASURED_POSITION).Assign(mStateJointMeasure.Position());
+    if (mGainSchedule.Active()) {
+        mGainSchedule.Evaluate(mStateJointMeasure.Position(), mGainScheduleVariable,
+                               KernelField(osaPIDKernel::KP),
+                               KernelField(osaPIDKernel::KI),
+                               KernelField(osaPIDKernel::KD));
+    }
+    // velocity used for the derivative term
+    mDerivativeFilter.Evaluate(mStateJointMeasure.Position(),
+                               mStateJointMeasure.Velocity(),
+                               mDerivativeVelocity);
+    KernelField(osaPIDKernel::MEASURED_VELOCITY).Assign(mDerivativeVelocity);
+    KernelField(osaPIDKernel::USER_EFFORT).Assign(mEffortUserCommand.ForceTorque());
+    // trajectory towards goal or smooth reference between setpoints
+    if (mTrajectoryGenerator.IsActive()) {
+        if (mTrajectoryGenerator.Evaluate(Now(),
+                                          mStateJointCommand.Position(),
+                                          mStateJointCommand.Velocity(),
+                                          mCommandAcceleration)) {
+            Events.GoalReached(true);
+        }
+    } else if (mInterpolator.Type() != osaSetpointInterpolator::NONE) {
+        mInterpolator.Evaluate(Now(),
+                               mStateJointCommand.Position(),
+                               mStateJointCommand.Velocity(),
+                               mCommandAcceleration);
+    }
+    KernelField(osaPIDKernel::COMMAND_POSITION).Assign(mStateJointCommand.Position());
+
+    // feed-forward, model is evaluated on commanded state
+    KernelField(osaPIDKernel::COMMAND_VELOCITY).Assign(mStateJointCommand.Velocity());
+    KernelField(osaPIDKernel::COMMAND_ACCELERATION).Assign(mCommandAcceleration);
+    if (mFeedForwardModel) {
+        mFeedForwardModel->Evaluate(mStateJointCommand.Position(),
+                                    mStateJointCommand.Velocity(),
+                                    mCommandAcceleration,
+                                    mModelEffort);
+        KernelField(osaPIDKernel::FEEDFORWARD_EFFORT).SumOf(mFeedForwardEffort, mModelEffort);
+    } else {
+        KernelField(osaPIDKernel::FEEDFORWARD_EFFORT).Assign(mFeedForwardEffort);
+    }
+}
 
-            // apply effort limits if needed
-            if (mApplyEffortLimit) {
-                if (*commandEffort > *effortUpperLimit) {
-                    *commandEffort = *effortUpperLimit;
-                } else if (*commandEffort < *effortLowerLimit) {
-                    *commandEffort = *effortLowerLimit;
-                }
-            }
-        } // end of enabled
+void mtsPID::RunAfterKernel(void)
+{
+    // results of the PID on all active joints
+    bool newTrackingError = false;
+    const bool anyTrackingError = mKernel->TrackingError(mKernelFirst, mNumberOfActiveJoints, newTrackingError);
+
+    mStateJointCommand.Position().Assign(KernelField(osaPIDKernel::COMMAND_POSITION));
+    mStateJointCommand.Effort().Assign(KernelField(osaPIDKernel::COMMAND_EFFORT));
+
+    // when disabled, commanded follows measured, restart from there
+    // at rest
+    if (!mEnabled) {
+        mStateJointCommand.Velocity().SetAll(0.0);
+        mCommandAcceleration.SetAll(0.0);
+        if (mTrajectoryGenerator.IsActive()) {
+            mTrajectoryGenerator.Stop();
+            Events.GoalReached(false);
+        }
+        if (mInterpolator.Type() != osaSetpointInterpolator::NONE) {
+            mInterpolator.Reset(mStateJointCommand.Position());
+        }
     }
 
     // report errors (tracking)
     if (mTrackingErrorEnabled && anyTrackingError) {
         Enable(false);
         if (newTrackingError) {
-            std::string message = this->Name + ": tracking error, mask (1 for error): ";
-            message.append(mTrackingErrorFlag.ToString());
-            mInterface->SendError(message);
-            CMN_LOG_CLASS_RUN_ERROR << message << std::endl
-                                    << "errors:     " << mError << std::endl
-                                    << "tolerances: " << mTrackingErrorTolerances << std::endl
-                                    << "measure:    " << mPositionMeasure.Position() << std::endl
-                                    << "command:    " << mStateJointCommand.Position() << std::endl;
+            mTrackingErrorFlag.Assign(KernelField(osaPIDKernel::TRACKING_ERROR));
+            mTrackingErrorSnapshot.Assign(KernelField(osaPIDKernel::POSITION_ERROR));
+            ReportEvent(EVENT_TRACKING_ERROR, mTrackingErrorFlag,
+                        &mTrackingErrorSnapshot, &mTrackingErrorTolerances,
+                        &(mStateJointMeasure.Position()), &(mStateJointCommand.Position()));
         }
     }
 
-    // save previous position with timestamp
-    mPositionMeasurePrevious = mPositionMeasure;
-
     // for simulated mode
     if (mIsSimulated) {
-        mPositionMeasure.SetValid(true);
-        mPositionMeasure.Position().Assign(mStateJointCommand.Position(), mNumberOfActiveJoints);
-        mEffortMeasure.Assign(mStateJointCommand.Effort(), mNumberOfActiveJoints);
+        if (mUseSimulatedPlant) {
+            // applied until the next call to GetIOData
+            if (mEnabled) {
+                mSimulatedPlant.SetEffort(mStateJointCommand.Effort());
+            } else {
+                mSimulatedPlant.ClearEffort();
+            }
+        } else {
+            mPositionMeasure.SetValid(true);
+            mPositionMeasure.Position().Assign(mStateJointCommand.Position(), mNumberOfActiveJoints);
+            mEffortMeasure.Assign(mStateJointCommand.Effort(), mNumberOfActiveJoints);
+        }
     } else {
         if (mEnabled) {
+            mLoopTiming.BeginIO();
             SetEffortLocal(mStateJointCommand.Effort());
+            mLoopTiming.EndIO();
         }
     }
+
+    // telemetry, Reserve returns 0 if not recording
+    double * record = mTelemetry.Reserve();
+    if (record) {
+        RecordTelemetry(record);
+        mTelemetry.Commit();
+    }
+
+    if (mLoopTiming.EndTick()) {
+        Events.LoopTiming(mLoopTiming.Summary());
+    }
 }
 
 
 void mtsPID::Cleanup(void)
 {
+    mTelemetryMutex.Lock();
+    mTelemetry.Stop();
+    mTelemetryMutex.Unlock();
+    mEvents.Stop();
     // cleanup
     mStateJointCommand.Effort().SetAll(0.0);
     if (!mIsSimulated) {
@@ -572,6 +901,179 @@ void mtsPID::Cleanup(void)
     }
 }
 
+void mtsPID::ConfigureTelemetry(const double bufferDuration)
+{
+    std::vector<std::string> columns;
+    columns.push_back("time");
+    const char * fields[TELEMETRY_FIELDS_PER_JOINT] = {
+        "position", "velocity", "effort",
+        "position_desired", "effort_desired",
+        "error", "integral"
+    };
+    for (size_t i = 0; i < mNumberOfActiveJoints; ++i) {
+        for (size_t field = 0; field < TELEMETRY_FIELDS_PER_JOINT; ++field) {
+            columns.push_back(mJointNames.at(i) + "/" + fields[field]);
+        }
+    }
+    const double period = this->GetPeriodicity();
+    const size_t capacity = (period > 0.0) ? static_cast<size_t>(bufferDuration / period) + 1 : 1000;
+    mTelemetry.Configure(columns, capacity);
+}
+
+void mtsPID::StartTelemetry(const std::string & filename)
+{
+    mTelemetryMutex.Lock();
+    const bool started = mTelemetry.Start(filename);
+    mTelemetryMutex.Unlock();
+    if (started) {
+        SendStatus(this->GetName() + ": recording telemetry to " + filename);
+    } else {
+        SendError(this->GetName() + ": failed to start telemetry in " + filename);
+    }
+}
+
+void mtsPID::StopTelemetry(void)
+{
+    mTelemetryMutex.Lock();
+    const bool recording = mTelemetry.IsRecording();
+    mTelemetry.Stop();
+    mTelemetryMutex.Unlock();
+    if (recording) {
+        SendStatus(this->GetName() + ": telemetry stopped");
+    }
+}
+
+void mtsPID::RecordTelemetry(double * record)
+{
+    *record = Now();
+    ++record;
+    const double * error = mKernel->Pointer(osaPIDKernel::POSITION_ERROR) + mKernelFirst;
+    const double * integral = mKernel->Pointer(osaPIDKernel::INTEGRAL_ERROR) + mKernelFirst;
+    for (size_t i = 0; i < mNumberOfActiveJoints; ++i) {
+        record[0] = mStateJointMeasure.Position()[i];
+        record[1] = mStateJointMeasure.Velocity()[i];
+        record[2] = mStateJointMeasure.Effort()[i];
+        record[3] = mStateJointCommand.Position()[i];
+        record[4] = mStateJointCommand.Effort()[i];
+        record[5] = error[i];
+        record[6] = integral[i];
+        record += TELEMETRY_FIELDS_PER_JOINT;
+    }
+}
+
+void mtsPID::ReportEvent(const EventType event, const vctBoolVec & mask,
+                         const vctDoubleVec * vector1,
+                         const vctDoubleVec * vector2,
+                         const vctDoubleVec * vector3,
+                         const vctDoubleVec * vector4)
+{
+    double * payload = mEvents.Reserve(event, Now());
+    if (!payload) {
+        return;
+    }
+    const size_t size = mNumberOfActiveJoints;
+    for (size_t index = 0; index < size; ++index) {
+        payload[index] = mask[index] ? 1.0 : 0.0;
+    }
+    const vctDoubleVec * vectors[EVENT_VECTORS - 1] = {vector1, vector2, vector3, vector4};
+    for (size_t vector = 0; vector < EVENT_VECTORS - 1; ++vector) {
+        double * destination = payload + (vector + 1) * size;
+        if (vectors[vector]) {
+            std::copy(vectors[vector]->begin(), vectors[vector]->end(), destination);
+        } else {
+            std::fill(destination, destination + size, 0.0);
+        }
+    }
+    mEvents.Commit();
+}
+
+void mtsPID::HandleEvent(const size_t code, const double time,
+                         const double * payload, const size_t suppressed)
+{
+    const size_t size = mNumberOfActiveJoints;
+    vctBoolVec mask(size);
+    for (size_t index = 0; index < size; ++index) {
+        mask[index] = (payload[index] != 0.0);
+    }
+    const vctDynamicConstVectorRef<double> vector1(size, payload + size);
+    const vctDynamicConstVectorRef<double> vector2(size, payload + 2 * size);
+    const vctDynamicConstVectorRef<double> vector3(size, payload + 3 * size);
+    const vctDynamicConstVectorRef<double> vector4(size, payload + 4 * size);
+
+    std::stringstream suppressedMessage;
+    if (suppressed > 0) {
+        suppressedMessage << " (" << suppressed << " similar events suppressed)";
+    }
+
+    std::string message;
+    switch (code) {
+    case EVENT_TRACKING_ERROR:
+        message = this->Name + ": tracking error, mask (1 for error): " + mask.ToString();
+        SendError(message + suppressedMessage.str());
+        CMN_LOG_CLASS_RUN_ERROR << message << suppressedMessage.str() << " at " << time << std::endl
+                                << "errors:     " << vector1 << std::endl
+                                << "tolerances: " << vector2 << std::endl
+                                << "measure:    " << vector3 << std::endl
+                                << "command:    " << vector4 << std::endl;
+        break;
+    case EVENT_POSITION_LIMIT:
+        message = this->Name + ": position limit, mask (1 for limit): " + mask.ToString();
+        SendWarning(message + suppressedMessage.str());
+        CMN_LOG_CLASS_RUN_WARNING << message << suppressedMessage.str() << " at " << time
+                                  << ", \n requested: " << vector1
+                                  << ", \n lower limits: " << vector2
+                                  << ", \n upper limits: " << vector3
+                                  << std::endl;
+        break;
+    case EVENT_SIMULATION_CLAMPED:
+        message = this->Name + ": simulated plant fell behind, time step clamped";
+        SendWarning(message + suppressedMessage.str());
+        CMN_LOG_CLASS_RUN_WARNING << message << suppressedMessage.str() << " at " << time
+                                  << ", maximum duration simulated per step: "
+                                  << mSimulatedPlant.MaximumDuration() << std::endl;
+        break;
+    case EVENT_GOAL_NOT_ENABLED:
+        message = this->Name + ": goal ignored, controller is not enabled";
+        SendWarning(message + suppressedMessage.str());
+        CMN_LOG_CLASS_RUN_WARNING << message << suppressedMessage.str() << " at " << time
+                                  << ", \n requested: " << vector1
+                                  << std::endl;
+        break;
+    case EVENT_GOAL_NO_TRAJECTORY_LIMITS:
+        message = this->Name + ": goal ignored, trajectory limits are not configured";
+        SendError(message + suppressedMessage.str());
+        CMN_LOG_CLASS_RUN_ERROR << message << suppressedMessage.str() << " at " << time
+                                << ", \n goal: " << vector1
+                                << ", \n command: " << vector2
+                                << std::endl;
+        break;
+    default:
+        CMN_LOG_CLASS_RUN_ERROR << "HandleEvent: unknown event code " << code << std::endl;
+        break;
+    }
+}
+
+void mtsPID::SendError(const std::string & message)
+{
+    mMessagesMutex.Lock();
+    mInterface->SendError(message);
+    mMessagesMutex.Unlock();
+}
+
+void mtsPID::SendWarning(const std::string & message)
+{
+    mMessagesMutex.Lock();
+    mInterface->SendWarning(message);
+    mMessagesMutex.Unlock();
+}
+
+void mtsPID::SendStatus(const std::string & message)
+{
+    mMessagesMutex.Lock();
+    mInterface->SendStatus(message);
+    mMessagesMutex.Unlock();
+}
+
 void mtsPID::SetSimulated(void)
 {
     mIsSimulated = true;
@@ -579,6 +1081,16 @@ void mtsPID::SetSimulated(void)
     RemoveInterfaceRequired("RobotJointTorqueInterface");
 }
 
+void mtsPID::SetSimulatedPlant(osaSimulatedPlant::Model * model)
+{
+    if (!mIsSimulated) {
+        SetSimulated();
+    }
+    mUseSimulatedPlant = true;
+    mSimulatedPlant.SetModel(model);
+    mSimulatedPlantTime = -1.0;
+}
+
 void mtsPID::SetPGain(const vctDoubleVec & gain)
 {
     if (gain.size() != mNumberOfActiveJoints) {
@@ -587,6 +1099,7 @@ void mtsPID::SetPGain(const vctDoubleVec & gain)
     }
     mConfigurationStateTable.Start();
     mGains.Kp.Assign(gain, mNumberOfActiveJoints);
+    UpdateKernelConfiguration();
     mConfigurationStateTable.Advance();
 }
 
@@ -598,6 +1111,7 @@ void mtsPID::SetDGain(const vctDoubleVec & gain)
     }
     mConfigurationStateTable.Start();
     mGains.Kd.Assign(gain, mNumberOfActiveJoints);
+    UpdateKernelConfiguration();
     mConfigurationStateTable.Advance();
 }
 
@@ -609,6 +1123,7 @@ void mtsPID::SetIGain(const vctDoubleVec & gain)
     }
     mConfigurationStateTable.Start();
     mGains.Ki.Assign(gain, mNumberOfActiveJoints);
+    UpdateKernelConfiguration();
     mConfigurationStateTable.Advance();
 }
 
@@ -620,6 +1135,7 @@ void mtsPID::SetPositionLowerLimit(const vctDoubleVec & lowerLimit)
     }
     mConfigurationStateTable.Start();
     mPositionLowerLimit.Assign(lowerLimit, mNumberOfActiveJoints);
+    UpdateKernelConfiguration();
     mConfigurationStateTable.Advance();
 }
 
@@ -631,6 +1147,7 @@ void mtsPID::SetPositionUpperLimit(const vctDoubleVec & upperLimit)
     }
     mConfigurationStateTable.Start();
     mPositionUpperLimit.Assign(upperLimit, mNumberOfActiveJoints);
+    UpdateKernelConfiguration();
     mConfigurationStateTable.Advance();
 }
 
@@ -642,6 +1159,7 @@ void mtsPID::SetEffortLowerLimit(const vctDoubleVec & lowerLimit)
     }
     mConfigurationStateTable.Start();
     mEffortLowerLimit.Assign(lowerLimit, mNumberOfActiveJoints);
+    UpdateKernelConfiguration();
     mConfigurationStateTable.Advance();
 
     mApplyEffortLimit = mEffortLowerLimit.Any() && mEffortUpperLimit.Any();
@@ -655,6 +1173,7 @@ void mtsPID::SetEffortUpperLimit(const vctDoubleVec & upperLimit)
     }
     mConfigurationStateTable.Start();
     mEffortUpperLimit.Assign(upperLimit, mNumberOfActiveJoints);
+    UpdateKernelConfiguration();
     mConfigurationStateTable.Advance();
 
     mApplyEffortLimit = mEffortLowerLimit.Any() && mEffortUpperLimit.Any();
@@ -668,6 +1187,7 @@ void mtsPID::SetMinIErrorLimit(const vctDoubleVec & iminlim)
     }
     mConfigurationStateTable.Start();
     mIErrorLimitMin.Assign(iminlim, mNumberOfActiveJoints);
+    UpdateKernelConfiguration();
     mConfigurationStateTable.Advance();
 }
 
@@ -679,29 +1199,32 @@ void mtsPID::SetMaxIErrorLimit(const vctDoubleVec & imaxlim)
     }
     mConfigurationStateTable.Start();
     mIErrorLimitMax.Assign(imaxlim, mNumberOfActiveJoints);
+    UpdateKernelConfiguration();
     mConfigurationStateTable.Advance();
 }
 
 void mtsPID::SetForgetIError(const double & forget)
 {
+    mConfigurationStateTable.Start();
     mIErrorForgetFactor.SetAll(forget);
+    UpdateKernelConfiguration();
+    mConfigurationStateTable.Advance();
 }
 
 void mtsPID::ResetController(void)
 {
     CMN_LOG_CLASS_RUN_VERBOSE << "Reset Controller" << std::endl;
-    mError.SetAll(0.0);
-    mIError.SetAll(0.0);
+    mKernel->Reset(mKernelFirst, mNumberOfActiveJoints);
     Enable(false);
 }
 
 void mtsPID::SetDesiredEffort(const prmForceTorqueJointSet & command)
 {
-    mEffortUserCommand = command;
     if (command.ForceTorque().size() != mNumberOfActiveJoints) {
         CMN_LOG_CLASS_INIT_ERROR << "SetDesiredEffort: size mismatch" << std::endl;
         return;
     }
+    mEffortUserCommand = command;
 }
 
 void mtsPID::SetDesiredPosition(const prmPositionJointSet & command)
@@ -712,8 +1235,119 @@ void mtsPID::SetDesiredPosition(const prmPositionJointSet & command)
         return;
     }
 
+    StopTrajectory();
     mStateJointCommand.Position().Assign(command.Goal(), mNumberOfActiveJoints);
+    // position only, no feed-forward
+    mStateJointCommand.Velocity().SetAll(0.0);
+    mCommandAcceleration.SetAll(0.0);
+    mFeedForwardEffort.SetAll(0.0);
+    ApplyPositionLimits();
+    if (mInterpolator.Type() != osaSetpointInterpolator::NONE) {
+        mInterpolator.SetGoal(mStateJointCommand.Position(), vctDoubleVec(),
+                              (command.Timestamp() > 0.0) ? command.Timestamp() : Now(),
+                              Now());
+    }
+}
+
+void mtsPID::SetDesiredState(const prmStateJoint & command)
+{
+    const size_t velocitySize = command.Velocity().size();
+    const size_t effortSize = command.Effort().size();
+    if ((command.Position().size() != mNumberOfActiveJoints)
+        || ((velocitySize != 0) && (velocitySize != mNumberOfActiveJoints))
+        || ((effortSize != 0) && (effortSize != mNumberOfActiveJoints))) {
+        CMN_LOG_CLASS_RUN_ERROR << "SetDesiredState: size mismatch" << std::endl;
+        return;
+    }
+
+    StopTrajectory();
+    mStateJointCommand.Position().Assign(command.Position());
+
+    // acceleration from successive commanded velocities
+    const double now = Now();
+    if (velocitySize == 0) {
+        mStateJointCommand.Velocity().SetAll(0.0);
+        mCommandAcceleration.SetAll(0.0);
+    } else {
+        const double dt = now - mCommandVelocityTime;
+        if ((mCommandVelocityTime > 0.0) && (dt > 0.0)) {
+            mCommandAcceleration.DifferenceOf(command.Velocity(), mStateJointCommand.Velocity());
+            mCommandAcceleration.Divide(dt);
+        } else {
+            mCommandAcceleration.SetAll(0.0);
+        }
+        mStateJointCommand.Velocity().Assign(command.Velocity());
+    }
+    mCommandVelocityTime = (velocitySize == 0) ? 0.0 : now;
+
+    if (effortSize == 0) {
+        mFeedForwardEffort.SetAll(0.0);
+    } else {
+        mFeedForwardEffort.Assign(command.Effort());
+    }
+    ApplyPositionLimits();
+    if (mInterpolator.Type() != osaSetpointInterpolator::NONE) {
+        mInterpolator.SetGoal(mStateJointCommand.Position(), mStateJointCommand.Velocity(),
+                              (command.Timestamp() > 0.0) ? command.Timestamp() : now,
+                              now);
+    }
+}
+
+void mtsPID::SetGoalPosition(const prmPositionJointSet & command)
+{
+    if (command.Goal().size() != mNumberOfActiveJoints) {
+        CMN_LOG_CLASS_RUN_ERROR << "SetGoalPosition: size mismatch" << std::endl;
+        return;
+    }
+    if (!mEnabled) {
+        ReportEvent(EVENT_GOAL_NOT_ENABLED, mJointsEnabled, &(command.Goal()));
+        Events.GoalReached(false);
+        return;
+    }
 
+    // goal within position limits
+    mTrajectoryGoal.Assign(command.Goal(), mNumberOfActiveJoints);
+    if (mCheckPositionLimit) {
+        for (size_t index = 0; index < mNumberOfActiveJoints; ++index) {
+            mTrajectoryGoal[index] = std::max(mPositionLowerLimit[index],
+                                              std::min(mPositionUpperLimit[index], mTrajectoryGoal[index]));
+        }
+    }
+
+    // start from current commanded state, possibly moving
+    mFeedForwardEffort.SetAll(0.0);
+    if (!mTrajectoryGenerator.SetGoal(mTrajectoryGoal,
+                                      mStateJointCommand.Position(),
+                                      mStateJointCommand.Velocity(),
+                                      mCommandAcceleration,
+                                      Now())) {
+        ReportEvent(EVENT_GOAL_NO_TRAJECTORY_LIMITS, mJointsEnabled,
+                    &mTrajectoryGoal, &(mStateJointCommand.Position()));
+        Events.GoalReached(false);
+        return;
+    }
+    // hold goal once reached
+    if (mInterpolator.Type() != osaSetpointInterpolator::NONE) {
+        mInterpolator.Reset(mTrajectoryGoal);
+    }
+}
+
+void mtsPID::StopTrajectory(void)
+{
+    if (mTrajectoryGenerator.IsActive()) {
+        mTrajectoryGenerator.Stop();
+        Events.GoalReached(false);
+    }
+}
+
+void mtsPID::SetFeedForwardModel(FeedForwardModel * model)
+{
+    mFeedForwardModel = model;
+    mModelEffort.SetAll(0.0);
+}
+
+void mtsPID::ApplyPositionLimits(void)
+{
     if (mCheckPositionLimit) {
         bool limitReached = false;
         vctDoubleVec::const_iterator upper = mPositionUpperLimit.begin();
@@ -735,17 +1369,18 @@ void mtsPID::SetDesiredPosition(const prmPositionJointSet & command)
             }
         }
         if (limitReached) {
+            // no feed-forward pushing against the limits
+            for (size_t index = 0; index < mNumberOfActiveJoints; ++index) {
+                if (mPositionLimitFlag[index]) {
+                    mStateJointCommand.Velocity()[index] = 0.0;
+                    mCommandAcceleration[index] = 0.0;
+                }
+            }
             if (mPositionLimitFlagPrevious.NotEqual(mPositionLimitFlag)) {
                 mPositionLimitFlagPrevious.Assign(mPositionLimitFlag);
                 Events.PositionLimit(mPositionLimitFlag);
-                std::string message = this->Name + ": position limit, mask (1 for limit): ";
-                message.append(mPositionLimitFlag.ToString());
-                mInterface->SendWarning(message);
-                CMN_LOG_CLASS_RUN_WARNING << message
-                                          << ", \n requested: " << mStateJointCommand.Position()
-                                          << ", \n lower limits: " << mPositionLowerLimit
-                                          << ", \n upper limits: " << mPositionUpperLimit
-                                          << std::endl;
+                ReportEvent(EVENT_POSITION_LIMIT, mPositionLimitFlag,
+                            &(mStateJointCommand.Position()), &mPositionLowerLimit, &mPositionUpperLimit);
             }
         }
     }
@@ -769,7 +1404,8 @@ void mtsPID::Enable(const bool & enable)
     }
     // reset error flags
     if (enable) {
-        mPreviousTrackingErrorFlag.SetAll(false);
+        KernelField(osaPIDKernel::TRACKING_ERROR).SetAll(0.0);
+        KernelField(osaPIDKernel::PREVIOUS_TRACKING_ERROR).SetAll(0.0);
         mTrackingErrorFlag.SetAll(false);
         mPositionLimitFlagPrevious.SetAll(false);
         mPositionLimitFlag.SetAll(false);
@@ -813,11 +1449,27 @@ void mtsPID::SetCoupling(const prmActuatorJointCoupling & coupling)
 void mtsPID::GetIOData(const bool computeVelocity)
 {
     // get data from IO if not in simulated mode
-    if (mIsSimulated) {
+    if (mIsSimulated && mUseSimulatedPlant) {
+        // integrate with efforts from the previous iteration, start
+        // at rest from the commanded position
+        const double now = Now();
+        if (mSimulatedPlantTime >= 0.0) {
+            if (mSimulatedPlant.Step(now - mSimulatedPlantTime) > 0.0) {
+                ReportEvent(EVENT_SIMULATION_CLAMPED, mJointsEnabled);
+            }
+        } else {
+            mSimulatedPlant.Reset(mStateJointCommand.Position());
+        }
+        mSimulatedPlantTime = now;
+        mPositionMeasure.SetValid(true);
+        mPositionMeasure.Position().Assign(mSimulatedPlant.Position(), mNumberOfActiveJoints);
+        mPositionMeasure.SetTimestamp(now);
+        mEffortMeasure.Assign(mSimulatedPlant.Effort(), mNumberOfActiveJoints);
+    } else if (mIsSimulated) {
         mPositionMeasure.SetValid(true);
         // set current position/effort based on goal
         mPositionMeasure.Position().Assign(mStateJointCommand.Position(), mNumberOfActiveJoints);
-        mPositionMeasure.SetTimestamp(StateTable.GetTic());
+        mPositionMeasure.SetTimestamp(Now());
         // measured effort
         mEffortMeasure.Assign(mEffortUserCommand.ForceTorque());
     } else {
@@ -830,26 +1482,16 @@ void mtsPID::GetIOData(const bool computeVelocity)
         Robot.GetFeedbackVelocity(mVelocityMeasure);
     } else {
         if (computeVelocity) {
-            // or compute an estimate from position
-            double dt = mPositionMeasure.Timestamp() - mPositionMeasurePrevious.Timestamp();
-            if (dt > 0) {
-                vctDoubleVec::const_iterator currentPosition = mPositionMeasure.Position().begin();
-                vctDoubleVec::const_iterator previousPosition = mPositionMeasurePrevious.Position().begin();
-                vctDoubleVec::iterator velocity;
-                const vctDoubleVec::iterator end = mVelocityMeasure.Velocity().end();
-                for (velocity = mVelocityMeasure.Velocity().begin();
-                     velocity != end;
-                     ++velocity) {
-                    *velocity = (*currentPosition - *previousPosition) / dt;
-                }
-            } else {
-                // dt is useless set to zero to be safe
-                mVelocityMeasure.Velocity().SetAll(0.0);
-            }
+            // or compute an estimate from positions, velocities are
+            // set to zero if timestamp didn't change
+            mVelocityEstimator.Estimate(mPositionMeasure.Position(),
+                                        mPositionMeasure.Timestamp(),
+                                        mVelocityMeasure.Velocity());
         } else {
             // user requested to not compute velocities, likely
-            // because previousPosition can't be trusted (e.g. after
+            // because previous positions can't be trusted (e.g. after
             // coupling change)
+            mVelocityEstimator.Reset();
             mVelocityMeasure.Velocity().SetAll(0.0);
         }
     }
@@ -860,6 +1502,18 @@ void mtsPID::GetIOData(const bool computeVelocity)
     mStateJointMeasure.Effort().Assign(mEffortMeasure, mNumberOfActiveJoints);
 }
 
+void mtsPID::GetStateJoint(prmStateJoint & state) const
+{
+    mStateJointMeasureAccessor->GetLatest(state);
+    state.Name() = mJointNames;
+}
+
+void mtsPID::GetStateJointDesired(prmStateJoint & state) const
+{
+    mStateJointCommandAccessor->GetLatest(state);
+    state.Name() = mJointNames;
+}
+
 void mtsPID::SetEffortLocal(const vctDoubleVec & effort)
 {
     mEffortPIDCommand.ForceTorque().Assign(effort, mNumberOfActiveJoints);
@@ -874,6 +1528,7 @@ void mtsPID::CouplingEventHandler(const prmActuatorJointCoupling & coupling)
         GetIOData(false); // don't estimate velocity based on previous
                           // position since that position might not be
                           // computed using same coupling
+        mDerivativeFilter.Reset();
         // reset commanded based on measured to have reasonable defaults
         mStateJointCommand.Position().Assign(mStateJointMeasure.Position());
         mStateJointCommand.Effort().Assign(mStateJointMeasure.Effort());
@@ -885,7 +1540,10 @@ void mtsPID::CouplingEventHandler(const prmActuatorJointCoupling & coupling)
 void mtsPID::SetTrackingErrorTolerances(const vctDoubleVec & tolerances)
 {
     if (tolerances.size() == mNumberOfActiveJoints) {
+        mConfigurationStateTable.Start();
         mTrackingErrorTolerances.Assign(tolerances, mNumberOfActiveJoints);
+        UpdateKernelConfiguration();
+        mConfigurationStateTable.Advance();
     } else {
         std::string message = this->Name + ": incorrect vector size for SetTrackingErrorTolerances";
         cmnThrow(message);
@@ -896,8 +1554,8 @@ void mtsPID::ErrorEventHandler(const mtsMessage & message)
 {
     if (this->mEnabled) {
         this->Enable(false);
-        mInterface->SendError(this->GetName() + ": received [" + message.Message + "]");
+        SendError(this->GetName() + ": received [" + message.Message + "]");
     } else {
-        mInterface->SendStatus(this->GetName() + ": received [" + message.Message + "]");
+        SendStatus(this->GetName() + ": received [" + message.Message + "]");
     }
 }
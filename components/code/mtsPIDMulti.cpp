@@ -0,0 +1,205 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnPath.h>
+#include <cisstCommon/cmnXMLPath.h>
+#include <cisstMultiTask/mtsManagerLocal.h>
+#include <cisstMultiTask/mtsStateTable.h>
+
+#include <sawControllers/mtsPIDMulti.h>
+
+CMN_IMPLEMENT_SERVICES_DERIVED_ONEARG(mtsPIDMulti, mtsTaskPeriodic, mtsTaskPeriodicConstructorArg);
+
+
+mtsPIDMulti::mtsPIDMulti(const std::string & componentName, const double periodInSeconds):
+    mtsTaskPeriodic(componentName, periodInSeconds)
+{
+    Init();
+}
+
+
+mtsPIDMulti::mtsPIDMulti(const mtsTaskPeriodicConstructorArg & arg):
+    mtsTaskPeriodic(arg)
+{
+    Init();
+}
+
+
+mtsPIDMulti::~mtsPIDMulti()
+{
+    // arms are owned by the component manager
+}
+
+
+void mtsPIDMulti::Init(void)
+{
+    mArmsConnected = false;
+}
+
+
+void mtsPIDMulti::Configure(const std::string & filename)
+{
+    CMN_LOG_CLASS_INIT_VERBOSE << "Configure: using " << filename << std::endl;
+    cmnXMLPath config;
+    config.SetInputSource(filename);
+
+    // relative file names are resolved using the configuration file directory first
+    cmnPath path;
+    const std::string::size_type separator = filename.find_last_of("/\\");
+    if (separator != std::string::npos) {
+        path.Add(filename.substr(0, separator));
+    }
+    path.Add(".");
+
+    char context[64];
+    for (int i = 0; ; i++) {
+        sprintf(context, "controllers/controller[%d]", i + 1);
+        std::string name, file;
+        if (!config.GetXMLValue(context, "@name", name)) {
+            break;
+        }
+        if (!config.GetXMLValue(context, "@file", file)) {
+            CMN_LOG_CLASS_INIT_ERROR << "Configure: controller \"" << name << "\" in file: "
+                                     << filename << " needs a \"file\"" << std::endl;
+            return;
+        }
+        std::string fullName = file;
+        if (file.empty() || (file[0] != '/')) {
+            fullName = path.Find(file);
+            if (fullName.empty()) {
+                CMN_LOG_CLASS_INIT_ERROR << "Configure: can't find file \"" << file
+                                         << "\" for controller \"" << name << "\"" << std::endl;
+                return;
+            }
+        }
+        AddArm(name, fullName);
+    }
+
+    if (mArms.empty()) {
+        CMN_LOG_CLASS_INIT_ERROR << "Configure: no controller found in " << filename << std::endl;
+    }
+}
+
+
+mtsPID * mtsPIDMulti::AddArm(const std::string & name, const std::string & filename)
+{
+    if (mArmsConnected) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddArm: can't add \"" << name
+                                 << "\" after ConnectArms" << std::endl;
+        return 0;
+    }
+    mtsPID * arm = new mtsPID(name, this->GetPeriodicity());
+    arm->Configure(filename);
+    if (arm->NumberOfActiveJoints() == 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddArm: no active joint for \"" << name
+                                 << "\", check " << filename << std::endl;
+        delete arm;
+        return 0;
+    }
+    if (!mtsManagerLocal::GetInstance()->AddComponent(arm)) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddArm: failed to add component \"" << name << "\"" << std::endl;
+        delete arm;
+        return 0;
+    }
+    mArms.push_back(arm);
+    return arm;
+}
+
+
+bool mtsPIDMulti::ConnectArms(void)
+{
+    if (mArmsConnected) {
+        return true;
+    }
+    mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+    const ArmsType::iterator end = mArms.end();
+    for (ArmsType::iterator arm = mArms.begin(); arm != end; ++arm) {
+        if (!componentManager->Connect((*arm)->GetName(), "ExecIn",
+                                       this->GetName(), "ExecOut")) {
+            CMN_LOG_CLASS_INIT_ERROR << "ConnectArms: failed to connect \""
+                                     << (*arm)->GetName() << "\" to \""
+                                     << this->GetName() << "\"" << std::endl;
+            return false;
+        }
+        // started and advanced by Run, around the batched evaluation
+        (*arm)->GetDefaultStateTable()->SetAutomaticAdvance(false);
+    }
+    UpdateKernel();
+    mArmsConnected = true;
+    return true;
+}
+
+
+void mtsPIDMulti::UpdateKernel(void)
+{
+    size_t numberOfJoints = 0;
+    ArmsType::iterator arm;
+    const ArmsType::iterator end = mArms.end();
+    for (arm = mArms.begin(); arm != end; ++arm) {
+        numberOfJoints += (*arm)->NumberOfActiveJoints();
+    }
+    mKernel.SetSize(numberOfJoints);
+    size_t first = 0;
+    for (arm = mArms.begin(); arm != end; ++arm) {
+        (*arm)->UseKernel(mKernel, first);
+        first += (*arm)->NumberOfActiveJoints();
+    }
+    CMN_LOG_CLASS_INIT_VERBOSE << "UpdateKernel: " << mArms.size() << " arms, "
+                               << numberOfJoints << " joints" << std::endl;
+}
+
+
+void mtsPIDMulti::Startup(void)
+{
+    if (!mArmsConnected) {
+        CMN_LOG_CLASS_INIT_ERROR << "Startup: ConnectArms has not been called, arms will not be executed"
+                                 << std::endl;
+    }
+}
+
+
+void mtsPIDMulti::Run(void)
+{
+    ProcessQueuedCommands();
+    if (!mArmsConnected) {
+        return;
+    }
+
+    // commands and IO for all arms, fills the kernel
+    ArmsType::iterator arm;
+    const ArmsType::iterator end = mArms.end();
+    for (arm = mArms.begin(); arm != end; ++arm) {
+        (*arm)->GetDefaultStateTable()->Start();
+        (*arm)->RunBeforeKernel();
+    }
+
+    // one evaluation for all joints, each arm checks its own tracking errors
+    bool newTrackingError = false;
+    mKernel.Evaluate(newTrackingError);
+
+    for (arm = mArms.begin(); arm != end; ++arm) {
+        (*arm)->RunAfterKernel();
+        (*arm)->GetDefaultStateTable()->Advance();
+    }
+    // the arms' Run, called via ExecOut, does nothing
+}
+
+
+void mtsPIDMulti::Cleanup(void)
+{
+}
@@ -0,0 +1,340 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <fstream>
+#include <sstream>
+
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+#include <sawControllers/mtsScriptedIO.h>
+
+CMN_IMPLEMENT_SERVICES_DERIVED(mtsScriptedIO, mtsComponent);
+
+bool mtsScriptedIO::Track::Load(const std::string & filename, const size_t minimumValues)
+{
+    std::ifstream input(filename.c_str());
+    if (!input.good()) {
+        CMN_LOG_INIT_ERROR << "mtsScriptedIO::Track::Load: unable to open \""
+                           << filename << "\"" << std::endl;
+        return false;
+    }
+    Times.clear();
+    Values.clear();
+    Index = 0;
+
+    std::string line;
+    std::vector<double> values;
+    size_t lineNumber = 0;
+    while (std::getline(input, line)) {
+        lineNumber++;
+        std::istringstream stream(line);
+        double value;
+        values.clear();
+        while (stream >> value) {
+            values.push_back(value);
+        }
+        // empty lines and comments
+        if (values.empty()) {
+            const size_t first = line.find_first_not_of(" \t\r");
+            if ((first == std::string::npos) || (line[first] == '#')) {
+                continue;
+            }
+        }
+        if ((NumberOfValues == 0) && !values.empty()) {
+            NumberOfValues = values.size() - 1;
+        }
+        if (values.empty()
+            || (values.size() < (minimumValues + 1))
+            || (values.size() > (NumberOfValues + 1))
+            || (!Times.empty() && (values[0] < Times.back()))) {
+            CMN_LOG_INIT_ERROR << "mtsScriptedIO::Track::Load: invalid sample on line "
+                               << lineNumber << " of \"" << filename
+                               << "\", expected time and " << minimumValues << " to "
+                               << NumberOfValues << " values, times can't decrease" << std::endl;
+            return false;
+        }
+        Times.push_back(values[0]);
+        values.resize(NumberOfValues + 1, 0.0);
+        Values.insert(Values.end(), values.begin() + 1, values.end());
+    }
+
+    if (Times.empty() || (NumberOfValues < minimumValues)) {
+        CMN_LOG_INIT_ERROR << "mtsScriptedIO::Track::Load: no valid sample in \""
+                           << filename << "\"" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void mtsScriptedIO::Track::Seek(const double time)
+{
+    while (((Index + 1) < Times.size()) && (Times[Index + 1] <= time)) {
+        Index++;
+    }
+}
+
+void mtsScriptedIO::JointInterface::Update(const double time)
+{
+    Samples.Seek(time);
+    const double * sample = Samples.Sample();
+    for (size_t index = 0; index < Samples.NumberOfValues; ++index) {
+        Position.Position().at(index) = sample[index];
+    }
+    Position.SetTimestamp(time);
+    Position.SetValid(true);
+}
+
+void mtsScriptedIO::JointInterface::GetPositionJoint(prmPositionJointGet & position) const
+{
+    position = Position;
+}
+
+void mtsScriptedIO::JointInterface::GetTorqueJoint(vctDoubleVec & effort) const
+{
+    effort.ForceAssign(Effort);
+}
+
+void mtsScriptedIO::JointInterface::GetJointType(prmJointTypeVec & jointType) const
+{
+    jointType = JointType;
+}
+
+void mtsScriptedIO::JointInterface::SetTorqueJoint(const prmForceTorqueJointSet & effort)
+{
+    if (effort.ForceTorque().size() == Effort.size()) {
+        Effort.Assign(effort.ForceTorque());
+    }
+}
+
+void mtsScriptedIO::JointInterface::SetCoupling(const prmActuatorJointCoupling & coupling)
+{
+    // positions are replayed, accept and forward
+    Coupling(coupling);
+}
+
+void mtsScriptedIO::CartesianInterface::Update(const double time)
+{
+    Samples.Seek(time);
+    const double * sample = Samples.Sample();
+    vctFrm4x4 frame;
+    frame.Translation().Assign(sample[0], sample[1], sample[2]);
+    for (size_t row = 0; row < 3; ++row) {
+        for (size_t column = 0; column < 3; ++column) {
+            frame.Element(row, column) = sample[3 + row * 3 + column];
+        }
+    }
+    // recorded rotations are rounded
+    Position.Position().FromNormalized(frame);
+    Position.SetTimestamp(time);
+    Position.SetValid(true);
+    GripperPosition = sample[12];
+}
+
+void mtsScriptedIO::CartesianInterface::GetPositionCartesian(prmPositionCartesianGet & position) const
+{
+    position = Position;
+}
+
+void mtsScriptedIO::CartesianInterface::GetGripperPosition(double & position) const
+{
+    position = GripperPosition;
+}
+
+void mtsScriptedIO::CartesianInterface::SetPositionCartesian(const prmPositionCartesianSet & position)
+{
+    PositionDesired = position;
+}
+
+void mtsScriptedIO::CartesianInterface::SetJawPosition(const double & position)
+{
+    JawPosition = position;
+}
+
+void mtsScriptedIO::CartesianInterface::SetRobotControlState(const std::string & state)
+{
+    ControlState = state;
+}
+
+void mtsScriptedIO::CartesianInterface::GetPositionCartesianDesired(prmPositionCartesianSet & position) const
+{
+    position = PositionDesired;
+}
+
+void mtsScriptedIO::CartesianInterface::GetRobotControlState(std::string & state) const
+{
+    state = ControlState;
+}
+
+void mtsScriptedIO::ButtonInterface::Update(const double time)
+{
+    while ((Sent < Samples.Times.size()) && (Samples.Times[Sent] <= time)) {
+        prmEventButton event;
+        event.SetType((Samples.Values[Sent] != 0.0) ? prmEventButton::PRESSED : prmEventButton::RELEASED);
+        event.SetTimestamp(Samples.Times[Sent]);
+        event.SetValid(true);
+        Button(event);
+        Sent++;
+    }
+}
+
+mtsScriptedIO::mtsScriptedIO(const std::string & componentName):
+    mtsComponent(componentName),
+    mTime(0.0)
+{
+}
+
+mtsScriptedIO::~mtsScriptedIO()
+{
+    for (size_t index = 0; index < mJoints.size(); ++index) {
+        delete mJoints[index];
+    }
+    for (size_t index = 0; index < mCartesians.size(); ++index) {
+        delete mCartesians[index];
+    }
+    for (size_t index = 0; index < mButtons.size(); ++index) {
+        delete mButtons[index];
+    }
+}
+
+bool mtsScriptedIO::AddJointInterface(const std::string & interfaceName,
+                                      const std::string & filename,
+                                      const prmJointTypeVec & jointType)
+{
+    JointInterface * joint = new JointInterface;
+    if (!joint->Samples.Load(filename, 1)
+        || (joint->Samples.NumberOfValues != jointType.size())) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddJointInterface: failed to load \"" << filename
+                                 << "\" or number of joints doesn't match types" << std::endl;
+        delete joint;
+        return false;
+    }
+    mtsInterfaceProvided * provided = AddInterfaceProvided(interfaceName);
+    if (!provided) {
+        delete joint;
+        return false;
+    }
+    joint->JointType = jointType;
+    joint->Position.Position().SetSize(jointType.size(), 0.0);
+    joint->Effort.SetSize(jointType.size(), 0.0);
+    joint->Update(mTime);
+
+    provided->AddCommandRead(&JointInterface::GetPositionJoint, joint,
+                             "GetPositionJoint", joint->Position);
+    provided->AddCommandRead(&JointInterface::GetTorqueJoint, joint,
+                             "GetTorqueJoint", joint->Effort);
+    provided->AddCommandRead(&JointInterface::GetJointType, joint,
+                             "GetJointType", joint->JointType);
+    provided->AddCommandWrite(&JointInterface::SetTorqueJoint, joint,
+                              "SetTorqueJoint");
+    provided->AddCommandWrite(&JointInterface::SetCoupling, joint,
+                              "SetCoupling");
+    provided->AddEventWrite(joint->Coupling, "Coupling", prmActuatorJointCoupling());
+    provided->AddEventWrite(joint->Error, "Error", std::string(""));
+    mJoints.push_back(joint);
+    return true;
+}
+
+bool mtsScriptedIO::AddCartesianInterface(const std::string & interfaceName,
+                                          const std::string & filename)
+{
+    CartesianInterface * cartesian = new CartesianInterface;
+    // translation, rotation and optional gripper
+    cartesian->Samples.NumberOfValues = 13;
+    if (!cartesian->Samples.Load(filename, 12)) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddCartesianInterface: failed to load \"" << filename
+                                 << "\"" << std::endl;
+        delete cartesian;
+        return false;
+    }
+    mtsInterfaceProvided * provided = AddInterfaceProvided(interfaceName);
+    if (!provided) {
+        delete cartesian;
+        return false;
+    }
+    cartesian->JawPosition = 0.0;
+    cartesian->Update(mTime);
+
+    provided->AddCommandRead(&CartesianInterface::GetPositionCartesian, cartesian,
+                             "GetPositionCartesian", cartesian->Position);
+    provided->AddCommandRead(&CartesianInterface::GetGripperPosition, cartesian,
+                             "GetGripperPosition", cartesian->GripperPosition);
+    provided->AddCommandWrite(&CartesianInterface::SetPositionCartesian, cartesian,
+                              "SetPositionCartesian");
+    provided->AddCommandWrite(&CartesianInterface::SetPositionCartesian, cartesian,
+                              "SetPositionGoalCartesian");
+    provided->AddCommandWrite(&CartesianInterface::SetJawPosition, cartesian,
+                              "SetJawPosition");
+    provided->AddCommandWrite(&CartesianInterface::SetRobotControlState, cartesian,
+                              "SetRobotControlState");
+    provided->AddCommandRead(&CartesianInterface::GetPositionCartesianDesired, cartesian,
+                             "GetPositionCartesianDesired", cartesian->PositionDesired);
+    provided->AddCommandRead(&CartesianInterface::GetRobotControlState, cartesian,
+                             "GetRobotControlState", cartesian->ControlState);
+    provided->AddEventWrite(cartesian->Error, "Error", std::string(""));
+    provided->AddEventWrite(cartesian->ManipClutch, "ManipClutch", prmEventButton());
+    mCartesians.push_back(cartesian);
+    return true;
+}
+
+bool mtsScriptedIO::AddButtonInterface(const std::string & interfaceName,
+                                       const std::string & filename)
+{
+    ButtonInterface * button = new ButtonInterface;
+    button->Samples.NumberOfValues = 1;
+    if (!button->Samples.Load(filename, 1)) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddButtonInterface: failed to load \"" << filename
+                                 << "\"" << std::endl;
+        delete button;
+        return false;
+    }
+    mtsInterfaceProvided * provided = AddInterfaceProvided(interfaceName);
+    if (!provided) {
+        delete button;
+        return false;
+    }
+    button->Sent = 0;
+    provided->AddEventWrite(button->Button, "Button", prmEventButton());
+    mButtons.push_back(button);
+    return true;
+}
+
+void mtsScriptedIO::SetTime(const double time)
+{
+    // restart
+    if (time < mTime) {
+        for (size_t index = 0; index < mJoints.size(); ++index) {
+            mJoints[index]->Samples.Index = 0;
+        }
+        for (size_t index = 0; index < mCartesians.size(); ++index) {
+            mCartesians[index]->Samples.Index = 0;
+        }
+        for (size_t index = 0; index < mButtons.size(); ++index) {
+            mButtons[index]->Sent = 0;
+        }
+    }
+    mTime = time;
+
+    for (size_t index = 0; index < mJoints.size(); ++index) {
+        mJoints[index]->Update(mTime);
+    }
+    for (size_t index = 0; index < mCartesians.size(); ++index) {
+        mCartesians[index]->Update(mTime);
+    }
+    for (size_t index = 0; index < mButtons.size(); ++index) {
+        mButtons[index]->Update(mTime);
+    }
+}
@@ -0,0 +1,93 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <sawControllers/mtsStateTableFootprint.h>
+
+size_t mtsStateTableFootprint::Bytes(const mtsStateTable & table) const
+{
+    for (size_t i = 0; i < mTables.size(); ++i) {
+        if (mTables[i].Table == &table) {
+            return mTables[i].BytesPerSample * table.GetHistoryLength();
+        }
+    }
+    return 0;
+}
+
+size_t mtsStateTableFootprint::Bytes(void) const
+{
+    size_t result = 0;
+    for (size_t i = 0; i < mTables.size(); ++i) {
+        result += Bytes(*(mTables[i].Table));
+    }
+    return result;
+}
+
+void mtsStateTableFootprint::ToStream(std::ostream & outputStream) const
+{
+    for (size_t i = 0; i < mTables.size(); ++i) {
+        const mtsStateTable & table = *(mTables[i].Table);
+        outputStream << table.GetName() << ": " << table.GetHistoryLength()
+                     << " samples of " << mTables[i].BytesPerSample
+                     << " bytes, " << Bytes(table) << " bytes" << std::endl;
+    }
+}
+
+size_t mtsStateTableFootprint::DataSize(const std::vector<std::string> & strings)
+{
+    size_t result = sizeof(strings) + strings.size() * sizeof(std::string);
+    for (size_t i = 0; i < strings.size(); ++i) {
+        result += strings[i].capacity();
+    }
+    return result;
+}
+
+size_t mtsStateTableFootprint::DataSize(const prmPositionJointGet & data)
+{
+    return sizeof(data) + data.Position().size() * sizeof(double);
+}
+
+size_t mtsStateTableFootprint::DataSize(const prmVelocityJointGet & data)
+{
+    return sizeof(data) + data.Velocity().size() * sizeof(double);
+}
+
+size_t mtsStateTableFootprint::DataSize(const prmForceTorqueJointSet & data)
+{
+    return sizeof(data) + data.ForceTorque().size() * sizeof(double);
+}
+
+size_t mtsStateTableFootprint::DataSize(const prmStateJoint & data)
+{
+    return sizeof(data)
+        + (data.Position().size() + data.Velocity().size() + data.Effort().size()) * sizeof(double)
+        + DataSize(data.Name()) - sizeof(data.Name());
+}
+
+mtsStateTableFootprint::TableEntry & mtsStateTableFootprint::Entry(const mtsStateTable & table)
+{
+    for (size_t i = 0; i < mTables.size(); ++i) {
+        if (mTables[i].Table == &table) {
+            return mTables[i];
+        }
+    }
+    TableEntry entry;
+    entry.Table = &table;
+    entry.BytesPerSample = 0;
+    mTables.push_back(entry);
+    return mTables.back();
+}
@@ -19,8 +19,10 @@ http://www.cisst.org/cisst/license.txt.
 
 // system include
 #include <iostream>
+#include <sstream>
 
 // cisst
+#include <cisstCommon/cmnXMLPath.h>
 #include <sawControllers/mtsTeleOperation.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 #include <cisstMultiTask/mtsInterfaceRequired.h>
@@ -54,16 +56,18 @@ void mtsTeleOperation::Init(void)
     this->RotationLocked = false;
     this->TranslationLocked = false;
 
-    this->StateTable.AddData(Master.PositionCartesianCurrent, "MasterCartesianPosition");
-    this->StateTable.AddData(Slave.PositionCartesianCurrent, "SlaveCartesianPosition");
+    Footprint.AddData(this->StateTable, Master.PositionCartesianCurrent, "MasterCartesianPosition");
+    Footprint.AddData(this->StateTable, Slave.PositionCartesianCurrent, "SlaveCartesianPosition");
+    Footprint.AddData(this->StateTable, LoopTiming.Summary(), "LoopTiming");
 
-    this->ConfigurationStateTable = new mtsStateTable(100, "Configuration");
+    // depth can be changed in Configure
+    this->ConfigurationStateTable = new mtsStateTable(10, "Configuration");
     this->ConfigurationStateTable->SetAutomaticAdvance(false);
     this->AddStateTable(this->ConfigurationStateTable);
-    this->ConfigurationStateTable->AddData(this->Scale, "Scale");
-    this->ConfigurationStateTable->AddData(this->RegistrationRotation, "RegistrationRotation");
-    this->ConfigurationStateTable->AddData(this->RotationLocked, "RotationLocked");
-    this->ConfigurationStateTable->AddData(this->TranslationLocked, "TranslationLocked");
+    Footprint.AddData(*(this->ConfigurationStateTable), this->Scale, "Scale");
+    Footprint.AddData(*(this->ConfigurationStateTable), this->RegistrationRotation, "RegistrationRotation");
+    Footprint.AddData(*(this->ConfigurationStateTable), this->RotationLocked, "RotationLocked");
+    Footprint.AddData(*(this->ConfigurationStateTable), this->TranslationLocked, "TranslationLocked");
 
     // Setup CISST Interface
     mtsInterfaceRequired * masterRequired = AddInterfaceRequired("Master");
@@ -103,6 +107,8 @@ void mtsTeleOperation::Init(void)
         // commands
         providedSettings->AddCommandReadState(StateTable, StateTable.PeriodStats,
                                               "GetPeriodStatistics"); // mtsIntervalStatistics
+        providedSettings->AddCommandReadState(StateTable, LoopTiming.Summary(),
+                                              "GetLoopTiming"); // see osaLoopTiming
 
         providedSettings->AddCommandWrite(&mtsTeleOperation::Enable, this, "Enable", false);
         providedSettings->AddCommandWrite(&mtsTeleOperation::SetScale, this, "SetScale", 0.5);
@@ -127,21 +133,47 @@ void mtsTeleOperation::Init(void)
         providedSettings->AddEventWrite(ConfigurationEvents.Scale, "Scale", 0.5);
         providedSettings->AddEventWrite(ConfigurationEvents.RotationLocked, "RotationLocked", false);
         providedSettings->AddEventWrite(ConfigurationEvents.TranslationLocked, "TranslationLocked", false);
+        providedSettings->AddEventWrite(LoopTimingEvent, "LoopTiming", vctDoubleVec());
     }
 }
 
 void mtsTeleOperation::Configure(const std::string & filename)
 {
     CMN_LOG_CLASS_INIT_VERBOSE << "Configure: " << filename << std::endl;
+
+    if (!filename.empty()) {
+        cmnXMLPath config;
+        config.SetInputSource(filename);
+
+        // history depth, tables can only be resized before they're used
+        int stateTableSize, configurationStateTableSize;
+        config.GetXMLValue("/teleoperation", "statetable/@Size", stateTableSize,
+                           static_cast<int>(StateTable.GetHistoryLength()));
+        config.GetXMLValue("/teleoperation", "statetable/@ConfigurationSize", configurationStateTableSize,
+                           static_cast<int>(ConfigurationStateTable->GetHistoryLength()));
+        if ((stateTableSize < 2) || (configurationStateTableSize < 2)) {
+            CMN_LOG_CLASS_INIT_ERROR << "Configure: state table sizes must be at least 2" << std::endl;
+        } else if (!StateTable.SetSize(stateTableSize)
+                   || !ConfigurationStateTable->SetSize(configurationStateTableSize)) {
+            CMN_LOG_CLASS_INIT_ERROR << "Configure: failed to resize state tables" << std::endl;
+        }
+    }
+
+    std::stringstream footprint;
+    Footprint.ToStream(footprint);
+    CMN_LOG_CLASS_INIT_VERBOSE << "Configure: state tables use " << Footprint.Bytes()
+                               << " bytes" << std::endl << footprint.str();
 }
 
 void mtsTeleOperation::Startup(void)
 {
     CMN_LOG_CLASS_INIT_VERBOSE << "Startup" << std::endl;
+    LoopTiming.Configure(this->GetPeriodicity());
 }
 
 void mtsTeleOperation::Run(void)
 {
+    LoopTiming.BeginTick();
     ProcessQueuedCommands();
     ProcessQueuedEvents();
 
@@ -149,6 +181,7 @@ void mtsTeleOperation::Run(void)
     Counter++;
 
     // get master Cartesian position
+    LoopTiming.BeginIO();
     mtsExecutionResult executionResult;
     executionResult = Master.GetPositionCartesian(Master.PositionCartesianCurrent);
     if (!executionResult.IsOK()) {
@@ -161,6 +194,7 @@ void mtsTeleOperation::Run(void)
 
     // get slave Cartesian position
     executionResult = Slave.GetPositionCartesian(Slave.PositionCartesianCurrent);
+    LoopTiming.EndIO();
     if (!executionResult.IsOK()) {
         CMN_LOG_CLASS_RUN_ERROR << "Run: call to Slave.GetPositionCartesian failed \""
                                 << executionResult << "\"" << std::endl;
@@ -218,6 +252,7 @@ void mtsTeleOperation::Run(void)
             Slave.PositionCartesianDesired.Goal().FromNormalized(slaveCartesianDesired);
 
             // Slave go this cartesian position
+            LoopTiming.BeginIO();
             Slave.SetPositionCartesian(Slave.PositionCartesianDesired);
 
             // Gripper
@@ -228,12 +263,17 @@ void mtsTeleOperation::Run(void)
             } else {
                 Slave.SetJawPosition(5.0 * cmnPI_180);
             }
+            LoopTiming.EndIO();
         } else if (!IsClutched && !IsOperatorPresent) {
             // Do nothing
         }
     } else {
         CMN_LOG_CLASS_RUN_DEBUG << "mtsTeleOperation disabled" << std::endl;
     }
+
+    if (LoopTiming.EndTick()) {
+        LoopTimingEvent(LoopTiming.Summary());
+    }
 }
 
 void mtsTeleOperation::Cleanup(void)
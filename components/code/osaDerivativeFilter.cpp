@@ -0,0 +1,159 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cmath>
+
+#include <cisstCommon/cmnConstants.h>
+#include <cisstCommon/cmnLogger.h>
+#include <sawControllers/osaDerivativeFilter.h>
+
+osaDerivativeFilter::osaDerivativeFilter(void):
+    mInitialize(true)
+{
+}
+
+void osaDerivativeFilter::SetSize(const size_t numberOfJoints)
+{
+    mFilter.SetSize(numberOfJoints);
+    mUsePosition.SetSize(numberOfJoints);
+    mB0.SetSize(numberOfJoints);
+    mB1.SetSize(numberOfJoints);
+    mB2.SetSize(numberOfJoints);
+    mA1.SetSize(numberOfJoints);
+    mA2.SetSize(numberOfJoints);
+    mGain.SetSize(numberOfJoints);
+    mState1.SetSize(numberOfJoints, 0.0);
+    mState2.SetSize(numberOfJoints, 0.0);
+    for (size_t joint = 0; joint < numberOfJoints; ++joint) {
+        SetNone(joint);
+    }
+}
+
+void osaDerivativeFilter::SetCoefficients(const size_t joint, const FilterType filter, const bool usePosition,
+                                          const double b0, const double b1, const double b2,
+                                          const double a1, const double a2)
+{
+    mFilter[joint] = filter;
+    mUsePosition[joint] = usePosition ? 1.0 : 0.0;
+    mB0[joint] = b0;
+    mB1[joint] = b1;
+    mB2[joint] = b2;
+    mA1[joint] = a1;
+    mA2[joint] = a2;
+    // all filters are stable so 1 + a1 + a2 is not null
+    mGain[joint] = (b0 + b1 + b2) / (1.0 + a1 + a2);
+    mInitialize = true;
+}
+
+void osaDerivativeFilter::SetNone(const size_t joint)
+{
+    SetCoefficients(joint, NONE, false, 1.0, 0.0, 0.0, 0.0, 0.0);
+}
+
+bool osaDerivativeFilter::SetButterworth(const size_t joint, const double cutoffFrequency, const double period)
+{
+    if ((period <= 0.0) || (cutoffFrequency <= 0.0) || (cutoffFrequency >= 0.5 / period)) {
+        CMN_LOG_INIT_ERROR << "osaDerivativeFilter::SetButterworth: cutoff frequency for joint "
+                           << joint << " must be positive and below Nyquist frequency" << std::endl;
+        return false;
+    }
+    // bilinear transform with frequency prewarping
+    const double K = tan(cmnPI * cutoffFrequency * period);
+    const double norm = 1.0 / (1.0 + sqrt(2.0) * K + K * K);
+    const double b0 = K * K * norm;
+    SetCoefficients(joint, BUTTERWORTH, false,
+                    b0, 2.0 * b0, b0,
+                    2.0 * (K * K - 1.0) * norm, (1.0 - sqrt(2.0) * K + K * K) * norm);
+    return true;
+}
+
+bool osaDerivativeFilter::SetTustin(const size_t joint, const double cutoffFrequency, const double period)
+{
+    if ((period <= 0.0) || (cutoffFrequency <= 0.0)) {
+        CMN_LOG_INIT_ERROR << "osaDerivativeFilter::SetTustin: cutoff frequency for joint "
+                           << joint << " must be positive" << std::endl;
+        return false;
+    }
+    // s / (tau s + 1) with s = 2 / T (1 - z^-1) / (1 + z^-1)
+    const double tau = 1.0 / (2.0 * cmnPI * cutoffFrequency);
+    const double b0 = 2.0 / (2.0 * tau + period);
+    SetCoefficients(joint, TUSTIN, true,
+                    b0, -b0, 0.0,
+                    (period - 2.0 * tau) / (2.0 * tau + period), 0.0);
+    return true;
+}
+
+bool osaDerivativeFilter::SetObserver(const size_t joint, const double processNoise, const double measurementNoise,
+                                      const double period)
+{
+    if ((period <= 0.0) || (processNoise <= 0.0) || (measurementNoise <= 0.0)) {
+        CMN_LOG_INIT_ERROR << "osaDerivativeFilter::SetObserver: noises for joint "
+                           << joint << " must be positive" << std::endl;
+        return false;
+    }
+    // steady state gains from tracking index (Kalata)
+    const double lambda = processNoise * period * period / measurementNoise;
+    const double r = (4.0 + lambda - sqrt(8.0 * lambda + lambda * lambda)) / 4.0;
+    const double alpha = 1.0 - r * r;
+    const double beta = 2.0 * (2.0 - alpha) - 4.0 * sqrt(1.0 - alpha);
+    // transfer function from measured position to estimated velocity:
+    // beta / T (1 - z^-1) / (1 - (2 - alpha - beta) z^-1 + (1 - alpha) z^-2)
+    SetCoefficients(joint, OBSERVER, true,
+                    beta / period, -beta / period, 0.0,
+                    -(2.0 - alpha - beta), 1.0 - alpha);
+    return true;
+}
+
+void osaDerivativeFilter::Evaluate(const vctDynamicConstVectorRef<double> & position,
+                                   const vctDynamicConstVectorRef<double> & velocity,
+                                   vctDynamicVectorRef<double> filtered)
+{
+    const size_t size = mFilter.size();
+    const double * p = position.Pointer();
+    const double * v = velocity.Pointer();
+    const double * usePosition = mUsePosition.Pointer();
+    const double * b0 = mB0.Pointer();
+    const double * b1 = mB1.Pointer();
+    const double * b2 = mB2.Pointer();
+    const double * a1 = mA1.Pointer();
+    const double * a2 = mA2.Pointer();
+    double * s1 = mState1.Pointer();
+    double * s2 = mState2.Pointer();
+    double * y = filtered.Pointer();
+
+    if (mInitialize) {
+        // steady state for current input, i.e. no derivative kick for
+        // position based filters
+        const double * gain = mGain.Pointer();
+        for (size_t i = 0; i < size; ++i) {
+            const double u = usePosition[i] * p[i] + (1.0 - usePosition[i]) * v[i];
+            const double output = gain[i] * u;
+            s2[i] = b2[i] * u - a2[i] * output;
+            s1[i] = b1[i] * u - a1[i] * output + s2[i];
+        }
+        mInitialize = false;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        const double u = usePosition[i] * p[i] + (1.0 - usePosition[i]) * v[i];
+        const double output = b0[i] * u + s1[i];
+        s1[i] = b1[i] * u - a1[i] * output + s2[i];
+        s2[i] = b2[i] * u - a2[i] * output;
+        y[i] = output;
+    }
+}
@@ -0,0 +1,138 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <algorithm>
+
+#include <cisstCommon/cmnLogger.h>
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <sawControllers/osaEventChannel.h>
+
+osaEventChannel::osaEventChannel(void):
+    mPayloadSize(0),
+    mReservedCode(0),
+    mReservedTime(0.0),
+    mDropped(0),
+    mRunning(0),
+    mStopRequested(0),
+    mUseThread(true),
+    mHandler(0)
+{
+}
+
+osaEventChannel::~osaEventChannel()
+{
+    Stop();
+}
+
+void osaEventChannel::Configure(const size_t numberOfCodes, const size_t payloadSize,
+                                const size_t capacity, const double minimumInterval)
+{
+    if (IsRunning()) {
+        CMN_LOG_INIT_ERROR << "osaEventChannel::Configure: can't configure while running" << std::endl;
+        return;
+    }
+    mPayloadSize = payloadSize;
+    mRing.Configure(HEADER_SIZE + mPayloadSize, capacity);
+    mMinimumInterval.assign(numberOfCodes, minimumInterval);
+    mLastTime.assign(numberOfCodes, -1.0);
+    mSuppressed.assign(numberOfCodes, 0);
+}
+
+void osaEventChannel::SetMinimumInterval(const size_t code, const double interval)
+{
+    mMinimumInterval.at(code) = interval;
+}
+
+bool osaEventChannel::Start(Handler * handler, const bool useThread)
+{
+    if (IsRunning()) {
+        Stop();
+    }
+    if (!handler || (mRing.Capacity() == 0) || mMinimumInterval.empty()) {
+        CMN_LOG_INIT_ERROR << "osaEventChannel::Start: not configured or no handler" << std::endl;
+        return false;
+    }
+    mHandler = handler;
+    // the producer doesn't commit while not running
+    mRing.Skip();
+    mDropped = 0;
+    std::fill(mLastTime.begin(), mLastTime.end(), -1.0);
+    std::fill(mSuppressed.begin(), mSuppressed.end(), 0);
+    osaRingBuffer::Store(mStopRequested, 0);
+    mUseThread = useThread;
+    osaRingBuffer::Store(mRunning, 1);
+    if (mUseThread) {
+        mThread.Create<osaEventChannel, int>(this, &osaEventChannel::Drain, 0, "Events");
+    }
+    return true;
+}
+
+void osaEventChannel::Stop(void)
+{
+    if (!IsRunning()) {
+        return;
+    }
+    osaRingBuffer::Store(mRunning, 0);
+    osaRingBuffer::Store(mStopRequested, 1);
+    if (mUseThread) {
+        mThread.Wait();
+    } else {
+        HandleEvents();
+    }
+    if (mDropped > 0) {
+        CMN_LOG_RUN_WARNING << "osaEventChannel::Stop: " << mDropped
+                            << " events dropped, ring buffer too small" << std::endl;
+    }
+}
+
+void osaEventChannel::DrainNow(void)
+{
+    if (!IsRunning() || mUseThread) {
+        return;
+    }
+    HandleEvents();
+}
+
+void * osaEventChannel::Drain(int)
+{
+    while (!osaRingBuffer::Load(mStopRequested)) {
+        HandleEvents();
+        osaSleep(10.0 * cmn_ms);
+    }
+    // last events committed before Stop
+    HandleEvents();
+    return 0;
+}
+
+void osaEventChannel::HandleEvents(void)
+{
+    size_t count;
+    const double * record = mRing.Peek(count);
+    while (record) {
+        for (size_t index = 0; index < count; ++index) {
+            mHandler->HandleEvent(static_cast<size_t>(record[0]), record[1],
+                                  record + HEADER_SIZE,
+                                  static_cast<size_t>(record[2]));
+            record += mRing.RecordSize();
+            // release the record to the producer
+            mRing.Release(1);
+        }
+        record = mRing.Peek(count);
+    }
+}
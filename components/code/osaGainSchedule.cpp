@@ -0,0 +1,141 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <algorithm>
+
+#include <cisstCommon/cmnLogger.h>
+#include <sawControllers/osaGainSchedule.h>
+
+void osaGainSchedule::Table::SetSize(const size_t numberOfJoints)
+{
+    mVariable.assign(numberOfJoints, NONE);
+    mFirst.assign(numberOfJoints, 0);
+    mCount.assign(numberOfJoints, 0);
+    mValue.clear();
+    mKp.clear();
+    mKi.clear();
+    mKd.clear();
+}
+
+bool osaGainSchedule::Table::SetJoint(const size_t joint, const VariableType variable,
+                                      const std::vector<double> & values,
+                                      const std::vector<double> & kp,
+                                      const std::vector<double> & ki,
+                                      const std::vector<double> & kd)
+{
+    const size_t count = values.size();
+    if ((joint >= size()) || (count == 0)
+        || (kp.size() != count) || (ki.size() != count) || (kd.size() != count)) {
+        CMN_LOG_INIT_ERROR << "osaGainSchedule::Table::SetJoint: invalid joint index or size mismatch for joint "
+                           << joint << std::endl;
+        return false;
+    }
+    for (size_t index = 1; index < count; ++index) {
+        if (values[index] <= values[index - 1]) {
+            CMN_LOG_INIT_ERROR << "osaGainSchedule::Table::SetJoint: values must be strictly increasing for joint "
+                               << joint << std::endl;
+            return false;
+        }
+    }
+    // append, previous points for this joint (if any) are not reused
+    mVariable[joint] = variable;
+    mFirst[joint] = mValue.size();
+    mCount[joint] = count;
+    mValue.insert(mValue.end(), values.begin(), values.end());
+    mKp.insert(mKp.end(), kp.begin(), kp.end());
+    mKi.insert(mKi.end(), ki.begin(), ki.end());
+    mKd.insert(mKd.end(), kd.begin(), kd.end());
+    return true;
+}
+
+bool osaGainSchedule::Table::Any(void) const
+{
+    for (size_t joint = 0; joint < mVariable.size(); ++joint) {
+        if ((mVariable[joint] != NONE) && (mCount[joint] > 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+osaGainSchedule::osaGainSchedule(void):
+    mNumberOfJoints(0),
+    mActive(false)
+{
+}
+
+void osaGainSchedule::SetSize(const size_t numberOfJoints)
+{
+    Table table;
+    table.SetSize(numberOfJoints);
+    mTables.SetAll(table);
+    mNumberOfJoints = numberOfJoints;
+    mActive = false;
+}
+
+bool osaGainSchedule::SetTable(const Table & table)
+{
+    if (table.size() != mNumberOfJoints) {
+        CMN_LOG_RUN_ERROR << "osaGainSchedule::SetTable: size mismatch, expected "
+                          << mNumberOfJoints << " joints, got "
+                          << table.size() << std::endl;
+        return false;
+    }
+    mTables.Back() = table;
+    mTables.Publish();
+    return true;
+}
+
+void osaGainSchedule::Evaluate(const vctDynamicConstVectorRef<double> & position,
+                               const vctDynamicConstVectorRef<double> & user,
+                               vctDynamicVectorRef<double> kp,
+                               vctDynamicVectorRef<double> ki,
+                               vctDynamicVectorRef<double> kd) const
+{
+    const Table & table = mTables.Front();
+    const size_t numberOfJoints = table.size();
+    for (size_t joint = 0; joint < numberOfJoints; ++joint) {
+        const int variable = table.mVariable[joint];
+        const size_t count = table.mCount[joint];
+        if ((variable == NONE) || (count == 0)) {
+            continue;
+        }
+        const double x = (variable == POSITION) ? position[joint] : user[joint];
+        const size_t first = table.mFirst[joint];
+        const double * values = &(table.mValue[first]);
+        // first point above x, constant outside the table
+        const size_t upper = std::upper_bound(values, values + count, x) - values;
+        size_t index;
+        double ratio;
+        if (upper == 0) {
+            index = 0;
+            ratio = 0.0;
+        } else if (upper == count) {
+            index = count - 1;
+            ratio = 0.0;
+        } else {
+            index = upper - 1;
+            ratio = (x - values[index]) / (values[upper] - values[index]);
+        }
+        const size_t i0 = first + index;
+        const size_t i1 = (ratio > 0.0) ? i0 + 1 : i0;
+        kp[joint] = table.mKp[i0] + ratio * (table.mKp[i1] - table.mKp[i0]);
+        ki[joint] = table.mKi[i0] + ratio * (table.mKi[i1] - table.mKi[i0]);
+        kd[joint] = table.mKd[i0] + ratio * (table.mKd[i1] - table.mKd[i0]);
+    }
+}
@@ -21,7 +21,110 @@ http://www.cisst.org/cisst/license.txt.
 
 osaGravityCompensation::osaGravityCompensation(const std::string& robfile,
 					       const vctFrame4x4<double>& Rtw0):
-    robManipulator( robfile, Rtw0 ){}
+    robManipulator( robfile, Rtw0 ),
+    gravityonly( true ),
+    gravity( 0.0, 0.0, 9.81 ),
+    masses( links.size(), 0.0 ),
+    centers( links.size() ),
+    modified( links.size(), false ),
+    prismatic( links.size(), false ),
+    axes( links.size() ),
+    origins( links.size() ),
+    centersw( links.size() ),
+    qd( links.size(), 0.0 ),
+    qdd( links.size(), 0.0 ){
+
+    // cache the mass data and the kinematics convention of each link
+    for( size_t i=0; i<links.size(); i++ ){
+	robMass mass = links[i].GetMassData();
+	masses[i] = mass.Mass();
+	centers[i] = mass.CenterOfMass();
+	robKinematics* kinematics = links[i].GetKinematics();
+	switch( kinematics->GetConvention() ){
+	case robKinematics::STANDARD_DH:
+	    modified[i] = false;
+	    break;
+	case robKinematics::MODIFIED_DH:
+	    modified[i] = true;
+	    break;
+	default:
+	    gravityonly = false;
+	    break;
+	}
+	prismatic[i] = ( kinematics->GetType() == robJoint::SLIDER );
+    }
+
+    if( gravityonly && !CheckGravityRNE() ){
+	CMN_LOG_INIT_WARNING << "osaGravityCompensation: gravity only RNE doesn't"
+			     << " match InverseDynamics for " << robfile
+			     << ", using InverseDynamics" << std::endl;
+	gravityonly = false;
+    }
+
+}
+
+void osaGravityCompensation::GravityRNE( const vctDynamicVector<double>& q,
+					 vctDynamicVector<double>& tau ){
+
+    // forward recursion: joint axes, joint origins and centers of
+    // mass in world frame
+    vctFrame4x4<double> Rtwi( Rtw0 );
+    for( size_t i=0; i<links.size(); i++ ){
+	// standard DH: joint i moves along/about z of the previous frame
+	if( !modified[i] ){
+	    axes[i].Assign( Rtwi.Rotation().Column( 2 ) );
+	    origins[i].Assign( Rtwi.Translation() );
+	}
+	Rtwi = Rtwi * links[i].ForwardKinematics( q[i] );
+	// modified DH: joint i moves along/about z of its own frame
+	if( modified[i] ){
+	    axes[i].Assign( Rtwi.Rotation().Column( 2 ) );
+	    origins[i].Assign( Rtwi.Translation() );
+	}
+	centersw[i] = Rtwi * centers[i];
+    }
+
+    // backward recursion: accumulate the mass and first moment of
+    // mass of all the links moved by each joint
+    double mass = 0.0;
+    vctFixedSizeVector<double,3> moment( 0.0 );
+    vctFixedSizeVector<double,3> arm, torque;
+    for( size_t i=links.size(); 0<i; i-- ){
+	const size_t j = i-1;
+	mass += masses[j];
+	moment += masses[j] * centersw[j];
+	if( prismatic[j] )
+	    { tau[j] = mass * axes[j].DotProduct( gravity ); }
+	else{
+	    arm.DifferenceOf( moment, mass * origins[j] );
+	    torque.CrossProductOf( arm, gravity );
+	    tau[j] = axes[j].DotProduct( torque );
+	}
+    }
+
+}
+
+bool osaGravityCompensation::CheckGravityRNE(){
+
+    vctDynamicVector<double> q( links.size(), 0.0 );
+    vctDynamicVector<double> tau( links.size(), 0.0 );
+    for( size_t k=0; k<3; k++ ){
+	// a few arbitrary configurations
+	for( size_t i=0; i<q.size(); i++ )
+	    { q[i] = 0.3 * k * ( ( i % 2 == 0 ) ? 1.0 : -1.0 ) + 0.1 * k * i; }
+	GravityRNE( q, tau );
+	vctDynamicVector<double> reference = InverseDynamics( q, qd, qdd );
+	vctDynamicVector<double> difference = tau - reference;
+	if( difference.MaxAbsElement() > 1e-6 * ( 1.0 + reference.MaxAbsElement() ) ){
+	    CMN_LOG_INIT_VERBOSE << "osaGravityCompensation: q = " << q << std::endl
+				 << " RNE: " << tau << std::endl
+				 << " ID:  " << reference << std::endl;
+	    return false;
+	}
+    }
+    return true;
+
+}
 
 osaGravityCompensation::Errno
 osaGravityCompensation::Evaluate
@@ -34,11 +137,32 @@ osaGravityCompensation::Evaluate
 	return osaGravityCompensation::EFAILURE;
     }
 
-    vctDynamicVector<double> qd( links.size(), 0.0 );   // zero velocity
-    vctDynamicVector<double> qdd( links.size(), 0.0 );  // zero acceleration
+    if( !gravityonly )
+	{ return EvaluateInverseDynamics( q, tau ); }
+
+    // only allocates the first time
+    if( tau.size() != links.size() )
+	{ tau.SetSize( links.size() ); }
+
+    GravityRNE( q, tau );
+
+    return osaGravityCompensation::ESUCCESS;
+
+}
+
+osaGravityCompensation::Errno
+osaGravityCompensation::EvaluateInverseDynamics
+( const vctDynamicVector<double>& q,
+  vctDynamicVector<double>& tau ){
+
+    if( q.size() != links.size() ){
+	CMN_LOG_RUN_ERROR << "size(q) = " << q.size() << " "
+			  << "N = " << links.size() << std::endl;
+	return osaGravityCompensation::EFAILURE;
+    }
 
-    // inverse dynamics
-    tau =  InverseDynamics( q, qd, qdd );
+    // inverse dynamics with zero velocity and acceleration
+    tau = InverseDynamics( q, qd, qdd );
 
     return osaGravityCompensation::ESUCCESS;
 
@@ -0,0 +1,490 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+/*
+
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include <cisstCommon/cmnPortability.h>
+#include <sawControllers/osaGravityCompensationTable.h>
+
+#if (CISST_OS != CISST_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// file layout, all fields are 8 bytes so the torques are aligned:
+// magic, number of links, model hash, base frame hash, number of grid
+// joints, for each grid joint: index, samples, lower, upper
+// nominal positions, tolerance, torques, exact cell flags
+static const char osaGravityCompensationTableMagic[8] = "SAWGCT2";
+
+// 2^d nodes are used to interpolate
+static const size_t osaGravityCompensationTableMaxJoints = 8;
+
+// bound on the samples of a grid joint read from a file
+static const unsigned long long osaGravityCompensationTableMaxSamples = 65536;
+
+// FNV-1a over the bytes of the values
+static unsigned long long osaGravityCompensationTableHash
+( const double* values, size_t n, unsigned long long hash ){
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>( values );
+    for( size_t i=0; i<n*sizeof( double ); i++ ){
+	hash ^= bytes[i];
+	hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static const unsigned long long osaGravityCompensationTableHashSeed = 14695981039346656037ULL;
+
+// link frames for two joint values cover the kinematic parameters and
+// joint type, masses and centers of mass the dynamic ones
+static unsigned long long osaGravityCompensationTableModelHash
+( osaGravityCompensation* model ){
+    unsigned long long hash = osaGravityCompensationTableHashSeed;
+    for( size_t i=0; i<model->links.size(); i++ ){
+	robMass mass = model->links[i].GetMassData();
+	const double m = mass.Mass();
+	const vctFixedSizeVector<double,3> center( mass.CenterOfMass() );
+	hash = osaGravityCompensationTableHash( &m, 1, hash );
+	hash = osaGravityCompensationTableHash( center.Pointer(), 3, hash );
+	for( size_t k=0; k<2; k++ ){
+	    const vctFrame4x4<double> Rtij( model->links[i].ForwardKinematics( 0.5 * k ) );
+	    hash = osaGravityCompensationTableHash( Rtij.Pointer(), 16, hash );
+	}
+    }
+    return hash;
+}
+
+osaGravityCompensationTable::osaGravityCompensationTable
+( osaGravityCompensation* model ):
+    model( model ),
+    N( model->links.size() ),
+    modelhash( osaGravityCompensationTableModelHash( model ) ),
+    basehash( osaGravityCompensationTableHash( model->Rtw0.Pointer(), 16,
+					       osaGravityCompensationTableHashSeed ) ),
+    nominaltolerance( 0.0 ),
+    torques( NULL ),
+    exact( NULL ),
+    mapping( NULL ),
+    mappingsize( 0 ),
+    cellindex( 0 ){}
+
+osaGravityCompensationTable::~osaGravityCompensationTable()
+{ Release(); }
+
+void osaGravityCompensationTable::Release(){
+#if (CISST_OS != CISST_WINDOWS)
+    if( mapping != NULL )
+	{ munmap( mapping, mappingsize ); }
+#endif
+    mapping = NULL;
+    mappingsize = 0;
+    torques = NULL;
+    exact = NULL;
+}
+
+size_t osaGravityCompensationTable::NumberOfNodes() const {
+    size_t nodes = 1;
+    for( size_t k=0; k<samples.size(); k++ )
+	{ nodes *= samples[k]; }
+    return nodes;
+}
+
+size_t osaGravityCompensationTable::NumberOfCells() const {
+    size_t cells = 1;
+    for( size_t k=0; k<samples.size(); k++ )
+	{ cells *= samples[k] - 1; }
+    return cells;
+}
+
+void osaGravityCompensationTable::Initialize(){
+
+    // last grid joint is contiguous
+    strides.resize( joints.size() );
+    size_t stride = 1;
+    for( size_t k=joints.size(); 0<k; k-- ){
+	strides[k-1] = stride;
+	stride *= samples[k-1];
+    }
+
+    ongrid.assign( N, false );
+    for( size_t k=0; k<joints.size(); k++ )
+	{ ongrid[ joints[k] ] = true; }
+
+    cell.assign( joints.size(), 0 );
+    fractions.assign( joints.size(), 0.0 );
+
+}
+
+osaGravityCompensationTable::Errno
+osaGravityCompensationTable::Build( const std::vector<size_t>& joints,
+				    const std::vector<double>& lower,
+				    const std::vector<double>& upper,
+				    const std::vector<size_t>& samples,
+				    const vctDynamicVector<double>& qnominal,
+				    double tolerance ){
+
+    const size_t d = joints.size();
+    if( d == 0 || osaGravityCompensationTableMaxJoints < d ||
+	lower.size() != d || upper.size() != d || samples.size() != d ){
+	CMN_LOG_INIT_ERROR << "osaGravityCompensationTable: need between 1 and "
+			   << osaGravityCompensationTableMaxJoints
+			   << " grid joints with bounds and samples" << std::endl;
+	return osaGravityCompensationTable::EFAILURE;
+    }
+    if( qnominal.size() != N ){
+	CMN_LOG_INIT_ERROR << "osaGravityCompensationTable: size(qnominal) = "
+			   << qnominal.size() << " N = " << N << std::endl;
+	return osaGravityCompensationTable::EFAILURE;
+    }
+    std::vector<bool> used( N, false );
+    for( size_t k=0; k<d; k++ ){
+	if( N <= joints[k] || used[ joints[k] ] ||
+	    samples[k] < 2 || !( lower[k] < upper[k] ) ){
+	    CMN_LOG_INIT_ERROR << "osaGravityCompensationTable: invalid grid joint "
+			       << joints[k] << std::endl;
+	    return osaGravityCompensationTable::EFAILURE;
+	}
+	used[ joints[k] ] = true;
+    }
+
+    Release();
+    this->joints = joints;
+    this->lower = lower;
+    this->upper = upper;
+    this->samples = samples;
+    this->qnominal = qnominal;
+    nominaltolerance = tolerance;
+    Initialize();
+
+    const size_t nodes = NumberOfNodes();
+    const size_t cells = NumberOfCells();
+    torquesbuffer.resize( nodes * N );
+    exactbuffer.assign( cells, 0 );
+
+    // exact torques at each node
+    vctDynamicVector<double> q( qnominal );
+    vctDynamicVector<double> tau( N, 0.0 );
+    for( size_t n=0; n<nodes; n++ ){
+	for( size_t k=0; k<d; k++ ){
+	    const size_t i = ( n / strides[k] ) % samples[k];
+	    q[ joints[k] ] = lower[k] + i * ( upper[k] - lower[k] ) / ( samples[k] - 1 );
+	}
+	if( model->Evaluate( q, tau ) != osaGravityCompensation::ESUCCESS )
+	    { return osaGravityCompensationTable::EFAILURE; }
+	std::copy( tau.begin(), tau.end(), torquesbuffer.begin() + n * N );
+    }
+    torques = &torquesbuffer[0];
+    exact = &exactbuffer[0];
+
+    // the interpolation error is the largest at the center of the
+    // cells, use the exact model for cells above tolerance
+    vctDynamicVector<double> interpolated( N, 0.0 );
+    double maxerror = 0.0;
+    size_t exactcells = 0;
+    for( size_t c=0; c<cells; c++ ){
+	size_t remainder = c;
+	for( size_t k=d; 0<k; k-- ){
+	    const size_t i = remainder % ( samples[k-1] - 1 );
+	    remainder /= samples[k-1] - 1;
+	    q[ joints[k-1] ] = lower[k-1] + ( i + 0.5 ) * ( upper[k-1] - lower[k-1] ) / ( samples[k-1] - 1 );
+	}
+	if( !Locate( q ) ||
+	    model->Evaluate( q, tau ) != osaGravityCompensation::ESUCCESS )
+	    { return osaGravityCompensationTable::EFAILURE; }
+	Interpolate( interpolated );
+	double error = 0.0;
+	for( size_t j=0; j<N; j++ )
+	    { error = std::max( error, fabs( interpolated[j] - tau[j] ) ); }
+	maxerror = std::max( maxerror, error );
+	if( tolerance < error ){
+	    exactbuffer[c] = 1;
+	    exactcells++;
+	}
+    }
+
+    CMN_LOG_INIT_VERBOSE << "osaGravityCompensationTable: " << nodes << " nodes, "
+			 << exactcells << "/" << cells << " cells above tolerance, "
+			 << "max error at cell centers " << maxerror << std::endl;
+
+    return osaGravityCompensationTable::ESUCCESS;
+
+}
+
+osaGravityCompensationTable::Errno
+osaGravityCompensationTable::Save( const std::string& filename ) const {
+
+    if( torques == NULL ){
+	CMN_LOG_RUN_ERROR << "osaGravityCompensationTable: nothing to save" << std::endl;
+	return osaGravityCompensationTable::EFAILURE;
+    }
+
+    std::ofstream file( filename.c_str(), std::ios::binary | std::ios::trunc );
+    if( !file.good() ){
+	CMN_LOG_RUN_ERROR << "osaGravityCompensationTable: can't open " << filename << std::endl;
+	return osaGravityCompensationTable::EFAILURE;
+    }
+
+    const unsigned long long n = N;
+    const unsigned long long d = joints.size();
+    file.write( osaGravityCompensationTableMagic, sizeof( osaGravityCompensationTableMagic ) );
+    file.write( reinterpret_cast<const char*>( &n ), sizeof( n ) );
+    file.write( reinterpret_cast<const char*>( &modelhash ), sizeof( modelhash ) );
+    file.write( reinterpret_cast<const char*>( &basehash ), sizeof( basehash ) );
+    file.write( reinterpret_cast<const char*>( &d ), sizeof( d ) );
+    for( size_t k=0; k<joints.size(); k++ ){
+	const unsigned long long joint = joints[k];
+	const unsigned long long nsamples = samples[k];
+	file.write( reinterpret_cast<const char*>( &joint ), sizeof( joint ) );
+	file.write( reinterpret_cast<const char*>( &nsamples ), sizeof( nsamples ) );
+	file.write( reinterpret_cast<const char*>( &lower[k] ), sizeof( double ) );
+	file.write( reinterpret_cast<const char*>( &upper[k] ), sizeof( double ) );
+    }
+    file.write( reinterpret_cast<const char*>( qnominal.Pointer() ), N * sizeof( double ) );
+    file.write( reinterpret_cast<const char*>( &nominaltolerance ), sizeof( double ) );
+    file.write( reinterpret_cast<const char*>( torques ), NumberOfNodes() * N * sizeof( double ) );
+    file.write( reinterpret_cast<const char*>( exact ), NumberOfCells() );
+
+    if( !file.good() ){
+	CMN_LOG_RUN_ERROR << "osaGravityCompensationTable: failed to write " << filename << std::endl;
+	return osaGravityCompensationTable::EFAILURE;
+    }
+    return osaGravityCompensationTable::ESUCCESS;
+
+}
+
+bool osaGravityCompensationTable::Parse( const char* data, size_t size ){
+
+    const size_t word = sizeof( unsigned long long );
+    size_t offset = 0;
+    if( size < 5 * word ||
+	memcmp( data, osaGravityCompensationTableMagic, word ) != 0 )
+	{ return false; }
+    offset += word;
+
+    unsigned long long n, model, base, d;
+    memcpy( &n, data + offset, word );      offset += word;
+    memcpy( &model, data + offset, word );  offset += word;
+    memcpy( &base, data + offset, word );   offset += word;
+    memcpy( &d, data + offset, word );      offset += word;
+    if( n != N ){
+	CMN_LOG_INIT_ERROR << "osaGravityCompensationTable: table has " << n
+			   << " links, model has " << N << std::endl;
+	return false;
+    }
+    if( model != modelhash || base != basehash ){
+	CMN_LOG_INIT_ERROR << "osaGravityCompensationTable: table was built for another "
+			   << ( model != modelhash ? "robot model" : "base frame" ) << std::endl;
+	return false;
+    }
+    if( d == 0 || osaGravityCompensationTableMaxJoints < d ||
+	size < offset + d * 4 * word + ( N + 1 ) * word )
+	{ return false; }
+
+    joints.resize( d );
+    samples.resize( d );
+    lower.resize( d );
+    upper.resize( d );
+    std::vector<bool> used( N, false );
+    // product of the samples, stops before size_t overflows
+    const size_t maxsize = static_cast<size_t>( -1 );
+    size_t nodes = 1;
+    for( size_t k=0; k<d; k++ ){
+	unsigned long long joint, nsamples;
+	memcpy( &joint, data + offset, word );     offset += word;
+	memcpy( &nsamples, data + offset, word );  offset += word;
+	memcpy( &lower[k], data + offset, word );  offset += word;
+	memcpy( &upper[k], data + offset, word );  offset += word;
+	if( N <= joint || used[ joint ] ||
+	    nsamples < 2 || osaGravityCompensationTableMaxSamples < nsamples ||
+	    !( lower[k] < upper[k] ) )
+	    { return false; }
+	if( maxsize / nsamples < nodes )
+	    { return false; }
+	nodes *= nsamples;
+	used[ joint ] = true;
+	joints[k] = joint;
+	samples[k] = nsamples;
+    }
+    qnominal.SetSize( N );
+    memcpy( qnominal.Pointer(), data + offset, N * word );  offset += N * word;
+    memcpy( &nominaltolerance, data + offset, word );      offset += word;
+
+    // cells < nodes, so the byte count only overflows on the torques
+    if( maxsize / ( N * sizeof( double ) ) < nodes )
+	{ return false; }
+    const size_t torquesize = nodes * N * sizeof( double );
+    const size_t cells = NumberOfCells();
+    if( size < offset || size - offset < torquesize ||
+	size - offset - torquesize < cells )
+	{ return false; }
+    torques = reinterpret_cast<const double*>( data + offset );
+    offset += torquesize;
+    exact = reinterpret_cast<const unsigned char*>( data + offset );
+
+    Initialize();
+    return true;
+
+}
+
+osaGravityCompensationTable::Errno
+osaGravityCompensationTable::Load( const std::string& filename ){
+
+    Release();
+    torquesbuffer.clear();
+    exactbuffer.clear();
+
+#if (CISST_OS != CISST_WINDOWS)
+    int fd = open( filename.c_str(), O_RDONLY );
+    if( fd < 0 ){
+	CMN_LOG_INIT_ERROR << "osaGravityCompensationTable: can't open " << filename << std::endl;
+	return osaGravityCompensationTable::EFAILURE;
+    }
+    struct stat status;
+    if( fstat( fd, &status ) != 0 || status.st_size == 0 ){
+	close( fd );
+	CMN_LOG_INIT_ERROR << "osaGravityCompensationTable: can't read " << filename << std::endl;
+	return osaGravityCompensationTable::EFAILURE;
+    }
+    mappingsize = status.st_size;
+    mapping = mmap( NULL, mappingsize, PROT_READ, MAP_SHARED, fd, 0 );
+    close( fd );
+    if( mapping == MAP_FAILED ){
+	mapping = NULL;
+	mappingsize = 0;
+	CMN_LOG_INIT_ERROR << "osaGravityCompensationTable: can't map " << filename << std::endl;
+	return osaGravityCompensationTable::EFAILURE;
+    }
+    const char* data = static_cast<const char*>( mapping );
+    const size_t size = mappingsize;
+#else
+    std::ifstream file( filename.c_str(), std::ios::binary | std::ios::ate );
+    if( !file.good() ){
+	CMN_LOG_INIT_ERROR << "osaGravityCompensationTable: can't open " << filename << std::endl;
+	return osaGravityCompensationTable::EFAILURE;
+    }
+    const size_t size = static_cast<size_t>( file.tellg() );
+    // doubles to keep the torques aligned
+    torquesbuffer.resize( size / sizeof( double ) + 1 );
+    file.seekg( 0 );
+    file.read( reinterpret_cast<char*>( &torquesbuffer[0] ), size );
+    const char* data = reinterpret_cast<const char*>( &torquesbuffer[0] );
+#endif
+
+    if( !Parse( data, size ) ){
+	CMN_LOG_INIT_ERROR << "osaGravityCompensationTable: invalid table in "
+			   << filename << std::endl;
+	Release();
+	return osaGravityCompensationTable::EFAILURE;
+    }
+    return osaGravityCompensationTable::ESUCCESS;
+
+}
+
+bool osaGravityCompensationTable::Locate( const vctDynamicVector<double>& q ){
+
+    for( size_t j=0; j<N; j++ ){
+	if( !ongrid[j] && nominaltolerance < fabs( q[j] - qnominal[j] ) )
+	    { return false; }
+    }
+
+    cellindex = 0;
+    for( size_t k=0; k<joints.size(); k++ ){
+	const double x = q[ joints[k] ];
+	if( x < lower[k] || upper[k] < x )
+	    { return false; }
+	const double s = ( x - lower[k] ) / ( upper[k] - lower[k] ) * ( samples[k] - 1 );
+	size_t i = static_cast<size_t>( s );
+	if( samples[k] - 2 < i )
+	    { i = samples[k] - 2; }
+	cell[k] = i;
+	fractions[k] = s - i;
+	cellindex = cellindex * ( samples[k] - 1 ) + i;
+    }
+    return true;
+
+}
+
+void osaGravityCompensationTable::Interpolate( vctDynamicVector<double>& tau ) const {
+
+    size_t base = 0;
+    for( size_t k=0; k<joints.size(); k++ )
+	{ base += cell[k] * strides[k]; }
+
+    tau.SetAll( 0.0 );
+    const size_t corners = static_cast<size_t>( 1 ) << joints.size();
+    for( size_t c=0; c<corners; c++ ){
+	double weight = 1.0;
+	size_t node = base;
+	for( size_t k=0; k<joints.size(); k++ ){
+	    if( ( c >> k ) & 1 ){
+		weight *= fractions[k];
+		node += strides[k];
+	    }
+	    else
+		{ weight *= 1.0 - fractions[k]; }
+	}
+	if( weight == 0.0 )
+	    { continue; }
+	const double* t = torques + node * N;
+	for( size_t j=0; j<N; j++ )
+	    { tau[j] += weight * t[j]; }
+    }
+
+}
+
+bool osaGravityCompensationTable::IsInterpolated( const vctDynamicVector<double>& q ){
+    return ( torques != NULL && q.size() == N && Locate( q ) && !exact[cellindex] );
+}
+
+double osaGravityCompensationTable::ExactCellsRatio() const {
+    if( exact == NULL )
+	{ return 1.0; }
+    const size_t cells = NumberOfCells();
+    size_t count = 0;
+    for( size_t c=0; c<cells; c++ )
+	{ if( exact[c] ) count++; }
+    return static_cast<double>( count ) / cells;
+}
+
+osaGravityCompensationTable::Errno
+osaGravityCompensationTable::Evaluate
+( const vctDynamicVector<double>& q,
+  vctDynamicVector<double>& tau ){
+
+    if( !IsInterpolated( q ) ){
+	if( model->Evaluate( q, tau ) != osaGravityCompensation::ESUCCESS )
+	    { return osaGravityCompensationTable::EFAILURE; }
+	return osaGravityCompensationTable::ESUCCESS;
+    }
+
+    // only allocates the first time
+    if( tau.size() != N )
+	{ tau.SetSize( N ); }
+
+    Interpolate( tau );
+
+    return osaGravityCompensationTable::ESUCCESS;
+
+}
@@ -0,0 +1,231 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <sawControllers/osaLoopTiming.h>
+
+void osaLoopTiming::Histogram::Configure(const double resolution, const size_t numberOfBins)
+{
+    mResolution = resolution;
+    mBins.resize(std::max(numberOfBins, static_cast<size_t>(1)));
+    Clear();
+}
+
+void osaLoopTiming::Histogram::Clear(void)
+{
+    std::fill(mBins.begin(), mBins.end(), 0);
+    mCount = 0;
+    mMax = 0.0;
+    mScanBin = 0;
+    mScanCumulated = 0;
+    std::fill(mStatistics, mStatistics + NUMBER_OF_STATISTICS, 0.0);
+}
+
+void osaLoopTiming::Histogram::Add(const double value)
+{
+    if (mBins.empty()) {
+        return;
+    }
+    const double position = value / mResolution;
+    size_t bin = mBins.size() - 1;
+    if (position < static_cast<double>(bin)) {
+        bin = (position > 0.0) ? static_cast<size_t>(position) : 0;
+    }
+    mBins[bin]++;
+    mCount++;
+    mMax = std::max(mMax, value);
+}
+
+void osaLoopTiming::Histogram::BeginScan(void)
+{
+    static const double fractions[MAX] = {0.5, 0.99, 0.999};
+    for (size_t statistic = 0; statistic < MAX; ++statistic) {
+        mTargets[statistic] = static_cast<size_t>(ceil(fractions[statistic] * mCount));
+        mStatistics[statistic] = 0.0;
+    }
+    mStatistics[MAX] = mMax;
+    mScanBin = 0;
+    mScanCumulated = 0;
+}
+
+bool osaLoopTiming::Histogram::Scan(size_t & numberOfBins)
+{
+    const size_t end = std::min(mScanBin + numberOfBins, mBins.size());
+    numberOfBins -= end - mScanBin;
+    for (; mScanBin < end; ++mScanBin) {
+        const size_t count = mBins[mScanBin];
+        if (count == 0) {
+            continue;
+        }
+        for (size_t statistic = 0; statistic < MAX; ++statistic) {
+            if ((mScanCumulated < mTargets[statistic])
+                && (mScanCumulated + count >= mTargets[statistic])) {
+                // upper bound of the bin, never above the max
+                mStatistics[statistic] = std::min((mScanBin + 1) * mResolution, mMax);
+            }
+        }
+        mScanCumulated += count;
+        mBins[mScanBin] = 0;
+    }
+    if (mScanBin < mBins.size()) {
+        return false;
+    }
+    mCount = 0;
+    mMax = 0.0;
+    return true;
+}
+
+osaLoopTiming::osaLoopTiming(void):
+    mActive(0),
+    mScanning(false),
+    mScanHistogram(0),
+    mBinsPerTick(1),
+    mPeriod(0.0),
+    mTicksPerSummary(1),
+    mTicksSinceSummary(0),
+    mTicks(0),
+    mOverruns(0),
+    mScanTicks(0),
+    mScanOverruns(0),
+    mTickStart(0.0),
+    mPreviousTickStart(0.0),
+    mIOStart(0.0),
+    mIOTime(0.0),
+    mSummary(SUMMARY_SIZE, 0.0)
+{
+}
+
+void osaLoopTiming::Configure(const double period,
+                              const size_t ticksPerSummary,
+                              const double resolution,
+                              const size_t numberOfBins)
+{
+    mPeriod = period;
+    mTicksPerSummary = ticksPerSummary;
+    if (mTicksPerSummary == 0) {
+        mTicksPerSummary = (period > 0.0) ? static_cast<size_t>(1.0 / period + 0.5) : 1;
+    }
+    mTicksPerSummary = std::max(mTicksPerSummary, static_cast<size_t>(1));
+    for (size_t set = 0; set < 2; ++set) {
+        for (size_t i = 0; i < NUMBER_OF_HISTOGRAMS; ++i) {
+            mHistograms[set][i].Configure(resolution, numberOfBins);
+        }
+    }
+    // the previous period has to be scanned before the next swap
+    const size_t bins = NUMBER_OF_HISTOGRAMS * mHistograms[0][0].NumberOfBins();
+    mBinsPerTick = (bins + mTicksPerSummary - 1) / mTicksPerSummary;
+    Reset();
+}
+
+void osaLoopTiming::Reset(void)
+{
+    for (size_t set = 0; set < 2; ++set) {
+        for (size_t i = 0; i < NUMBER_OF_HISTOGRAMS; ++i) {
+            mHistograms[set][i].Clear();
+        }
+    }
+    mActive = 0;
+    mScanning = false;
+    mScanHistogram = 0;
+    mTicksSinceSummary = 0;
+    mTicks = 0;
+    mOverruns = 0;
+    mScanTicks = 0;
+    mScanOverruns = 0;
+    mPreviousTickStart = 0.0;
+    mSummary.SetAll(0.0);
+}
+
+void osaLoopTiming::BeginTick(void)
+{
+    mTickStart = osaGetTime();
+    mIOTime = 0.0;
+    // jitter is the difference between the actual and nominal periods
+    if (mPreviousTickStart > 0.0) {
+        mHistograms[mActive][JITTER].Add(fabs(mTickStart - mPreviousTickStart - mPeriod));
+    }
+    mPreviousTickStart = mTickStart;
+}
+
+void osaLoopTiming::BeginIO(void)
+{
+    mIOStart = osaGetTime();
+}
+
+void osaLoopTiming::EndIO(void)
+{
+    mIOTime += osaGetTime() - mIOStart;
+}
+
+bool osaLoopTiming::EndTick(void)
+{
+    const double tick = osaGetTime() - mTickStart;
+    mHistograms[mActive][COMPUTE].Add(tick - mIOTime);
+    mHistograms[mActive][IO].Add(mIOTime);
+    mTicks++;
+    if ((mPeriod > 0.0) && (tick > mPeriod)) {
+        mOverruns++;
+    }
+    bool updated = false;
+    if (mScanning) {
+        updated = ContinueSummary();
+    }
+    mTicksSinceSummary++;
+    if (mTicksSinceSummary >= mTicksPerSummary) {
+        BeginSummary();
+    }
+    return updated;
+}
+
+void osaLoopTiming::BeginSummary(void)
+{
+    // mBinsPerTick guarantees the previous scan is over
+    mActive = 1 - mActive;
+    for (size_t i = 0; i < NUMBER_OF_HISTOGRAMS; ++i) {
+        mHistograms[1 - mActive][i].BeginScan();
+    }
+    mScanHistogram = 0;
+    mScanTicks = mTicks;
+    mScanOverruns = mOverruns;
+    mScanning = true;
+    mTicksSinceSummary = 0;
+}
+
+bool osaLoopTiming::ContinueSummary(void)
+{
+    size_t bins = mBinsPerTick;
+    while (mScanHistogram < NUMBER_OF_HISTOGRAMS) {
+        if (!mHistograms[1 - mActive][mScanHistogram].Scan(bins)) {
+            return false;
+        }
+        mScanHistogram++;
+    }
+    mSummary[SUMMARY_TICKS] = static_cast<double>(mScanTicks);
+    mSummary[SUMMARY_OVERRUNS] = static_cast<double>(mScanOverruns);
+    for (size_t i = 0; i < NUMBER_OF_HISTOGRAMS; ++i) {
+        double * statistics = mSummary.Pointer(SUMMARY_HISTOGRAMS + i * NUMBER_OF_STATISTICS);
+        for (size_t statistic = 0; statistic < NUMBER_OF_STATISTICS; ++statistic) {
+            statistics[statistic] = mHistograms[1 - mActive][i].Statistic(static_cast<StatisticType>(statistic));
+        }
+    }
+    mScanning = false;
+    return true;
+}
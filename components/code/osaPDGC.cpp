@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <sawControllers/osaPDGC.h>
 
 osaPDGC::osaPDGC( const std::string& robfile, 
@@ -5,11 +7,16 @@ osaPDGC::osaPDGC( const std::string& robfile,
 		  const vctDynamicMatrix<double>& Kp,
 		  const vctDynamicMatrix<double>& Kd,
 		  const vctDynamicVector<double>& qinit ):
-  robManipulator( robfile, Rtw0 ),
+  osaGravityCompensation( robfile, Rtw0 ),
   Kp( Kp ),
   Kd( Kd ),
   qold( qinit ),
-  eold( qinit.size(), 0.0 ){
+  eold( qinit.size(), 0.0 ),
+  e( links.size(), 0.0 ),
+  ed( links.size(), 0.0 ),
+  Kpdiag( links.size(), 0.0 ),
+  Kddiag( links.size(), 0.0 ),
+  bandwidth( 0 ){
 
   if( Kp.rows() != links.size() || Kp.cols() != links.size() ){
     CMN_LOG_RUN_ERROR << "size(Kp) = [" << Kp.rows() 
@@ -32,6 +39,48 @@ osaPDGC::osaPDGC( const std::string& robfile,
 		      << "N = "          << links.size() << std::endl;
   }
 
+  UpdateBandwidth();
+
+}
+
+void osaPDGC::UpdateBandwidth(){
+
+  bandwidth = 0;
+  if( Kp.rows() != links.size() || Kp.cols() != links.size() ||
+      Kd.rows() != links.size() || Kd.cols() != links.size() )
+    { return; }
+
+  for( size_t i=0; i<links.size(); i++ ){
+    Kpdiag[i] = Kp.Element( i, i );
+    Kddiag[i] = Kd.Element( i, i );
+    for( size_t j=0; j<links.size(); j++ ){
+      const size_t distance = ( i < j ) ? j - i : i - j;
+      if( bandwidth < distance &&
+	  ( Kp.Element( i, j ) != 0.0 || Kd.Element( i, j ) != 0.0 ) )
+	{ bandwidth = distance; }
+    }
+  }
+
+}
+
+osaPDGC::Errno
+osaPDGC::SetGains
+( const vctDynamicMatrix<double>& Kp,
+  const vctDynamicMatrix<double>& Kd ){
+
+  if( Kp.rows() != links.size() || Kp.cols() != links.size() ||
+      Kd.rows() != links.size() || Kd.cols() != links.size() ){
+    CMN_LOG_RUN_ERROR << "size(Kp) = [" << Kp.rows() << ", " << Kp.cols() << " ] "
+		      << "size(Kd) = [" << Kd.rows() << ", " << Kd.cols() << " ] "
+		      << "N = "         << links.size() << std::endl;
+    return osaPDGC::EFAILURE;
+  }
+
+  this->Kp.Assign( Kp );
+  this->Kd.Assign( Kd );
+  UpdateBandwidth();
+  return osaPDGC::ESUCCESS;
+
 }
 
 osaPDGC::Errno
@@ -53,25 +102,49 @@ osaPDGC::Evaluate
     return osaPDGC::EFAILURE;
   }
 
-  // evaluate the velocity
-  vctDynamicVector<double> qd( links.size(), 0.0 );
-  if( 0 < dt ) qd = (q - qold)/dt;
-    
+  if( Kp.rows() != links.size() || Kp.cols() != links.size() ||
+      Kd.rows() != links.size() || Kd.cols() != links.size() ){
+    CMN_LOG_RUN_ERROR << "size(Kp) = [" << Kp.rows() << ", " << Kp.cols() << " ] "
+		      << "size(Kd) = [" << Kd.rows() << ", " << Kd.cols() << " ] "
+		      << "N = "         << links.size() << std::endl;
+    return osaPDGC::EFAILURE;
+  }
+
+  // Compute the gravity load, only allocates the first time
+  if( osaGravityCompensation::Evaluate( q, tau ) != osaGravityCompensation::ESUCCESS )
+    { return osaPDGC::EFAILURE; }
+
   // error = current - desired
-  vctDynamicVector<double> e = q - qs;
-    
+  e.DifferenceOf( q, qs );
+
   // error time derivative
-  vctDynamicVector<double> ed( links.size(), 0.0 );
-  if( 0 < dt ) ed = (e - eold)/dt;      
-    
-  // Compute the coriolis+gravity load
-  vctDynamicVector<double> ccg = 
-    CCG( q, vctDynamicVector<double>( links.size(), 0.0 ) );
-    
-  tau = ccg - Kp*e - Kd*ed;
-    
-  eold = e;
-  qold = q;
+  if( 0 < dt ){
+    ed.DifferenceOf( e, eold );
+    ed.Divide( dt );
+  }
+  else
+    { ed.SetAll( 0.0 ); }
+
+  // tau = G(q) - Kp*e - Kd*ed
+  const size_t N = links.size();
+  if( bandwidth == 0 ){
+    for( size_t i=0; i<N; i++ )
+      { tau[i] -= Kpdiag[i] * e[i] + Kddiag[i] * ed[i]; }
+  }
+  else{
+    for( size_t i=0; i<N; i++ ){
+      const size_t first = ( bandwidth < i ) ? i - bandwidth : 0;
+      const size_t last = std::min( N, i + bandwidth + 1 );
+      double sum = 0.0;
+      for( size_t j=first; j<last; j++ )
+	{ sum += Kp.Element( i, j ) * e[j] + Kd.Element( i, j ) * ed[j]; }
+      tau[i] -= sum;
+    }
+  }
+
+  // only resized if qinit didn't match
+  eold.ForceAssign( e );
+  qold.ForceAssign( q );
 
   return osaPDGC::ESUCCESS;
 
@@ -36,7 +36,9 @@ osaPIDAntiWindup::osaPIDAntiWindup( const vctDynamicVector<double>& Kp,
     outputs( limits.size(), 0.0 ),
     limits( limits.size(), 0.0 ),
     qold( qinit ),
-    eold( qinit.size(), 0.0 ){
+    eold( qinit.size(), 0.0 ),
+    e( qinit.size(), 0.0 ),
+    ed( qinit.size(), 0.0 ){
 
     if( this->Kp.size() != this->Kd.size() || 
         this->Kp.size() != this->Ki.size() || 
@@ -73,6 +75,24 @@ osaPIDAntiWindup::Evaluate
 ( const vctDynamicVector<double>& qs,
   const vctDynamicVector<double>& q,
   vctDynamicVector<double>& tau,
+  double dt ){
+
+    // only allocates the first time
+    if( tau.size() != Kp.size() )
+        { tau.SetSize( Kp.size() ); }
+
+    return Evaluate( vctDynamicConstVectorRef<double>( qs ),
+                     vctDynamicConstVectorRef<double>( q ),
+                     vctDynamicVectorRef<double>( tau ),
+                     dt );
+
+}
+
+osaPIDAntiWindup::Errno
+osaPIDAntiWindup::Evaluate
+( const vctDynamicConstVectorRef<double>& qs,
+  const vctDynamicConstVectorRef<double>& q,
+  vctDynamicVectorRef<double> tau,
   double dt ){
 
     if( dt <= 0 ){
@@ -92,14 +112,18 @@ osaPIDAntiWindup::Evaluate
         return osaPIDAntiWindup::EFAILURE;
     }
 
+    if( tau.size() != Kp.size() ){
+        std::cerr << "size(tau) = " << tau.size() << " "
+                          << "N = "         << Kp.size() << std::endl;
+        return osaPIDAntiWindup::EFAILURE;
+    }
+
     // error = desired - current
-    vctDynamicVector<double> e = qs - q;
+    e.DifferenceOf( qs, q );
 
-    // evaluate the velocity
-    vctDynamicVector<double> qd = (q - qold)/dt;
-    
     // error time derivative
-    vctDynamicVector<double> ed = (e - eold)/dt;      
+    ed.DifferenceOf( e, eold );
+    ed.Divide( dt );
     
     // command with anti windup
     for( size_t i=0; i<commands.size(); i++ ){
@@ -107,21 +131,18 @@ osaPIDAntiWindup::Evaluate
         commands[i] = Kp[i]*e[i] + Kd[i]*ed[i] + I[i];
     }
 
-    // set the output to the command
-    outputs = commands;
-
-    // saturate the output
+    // set the output to the command and saturate it
     for( size_t i=0; i<outputs.size(); i++ ){
+        outputs[i] = commands[i];
         if( outputs[i] < -limits[i] ) { outputs[i] = -limits[i]; }
         if( limits[i]  < outputs[i] ) { outputs[i] =  limits[i]; }
     }
     
-    tau = outputs;
+    tau.Assign( outputs );
 
-    eold = e;
-    qold = q;
+    eold.Assign( e );
+    qold.Assign( q );
     
     return osaPIDAntiWindup::ESUCCESS;
     
 }
-
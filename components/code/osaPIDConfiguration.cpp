@@ -0,0 +1,650 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include <cisstCommon/cmnConstants.h>
+#include <cisstCommon/cmnLogger.h>
+#include <cisstCommon/cmnTypeTraits.h>
+#include <cisstCommon/cmnUnits.h>
+#include <cisstCommon/cmnXMLPath.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <sawControllers/osaPIDConfiguration.h>
+
+static const char osaPIDConfigurationMagic[8] = "SAWPID1";
+
+// FNV-1a, 64 bits
+static unsigned long long osaPIDConfigurationHash(const char * data, const size_t size)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    for (size_t index = 0; index < size; ++index) {
+        hash ^= static_cast<unsigned char>(data[index]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// archives used to serialize all data members with a single list,
+// see osaPIDConfigurationSerialize
+class osaPIDConfigurationWriter
+{
+public:
+    osaPIDConfigurationWriter(std::string & buffer):
+        mBuffer(buffer)
+    {}
+
+    template <class _type>
+    inline void operator()(_type & value) {
+        mBuffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    inline void operator()(std::string & value) {
+        unsigned long long size = value.size();
+        (*this)(size);
+        mBuffer.append(value);
+    }
+
+    inline void operator()(std::vector<double> & values) {
+        unsigned long long size = values.size();
+        (*this)(size);
+        if (size > 0) {
+            mBuffer.append(reinterpret_cast<const char *>(&(values[0])), size * sizeof(double));
+        }
+    }
+
+    template <class _enum>
+    inline void Enum(_enum & value) {
+        int integer = static_cast<int>(value);
+        (*this)(integer);
+    }
+
+protected:
+    std::string & mBuffer;
+};
+
+class osaPIDConfigurationReader
+{
+public:
+    osaPIDConfigurationReader(const std::string & buffer):
+        mBuffer(buffer),
+        mOffset(0),
+        mValid(true)
+    {}
+
+    template <class _type>
+    inline void operator()(_type & value) {
+        if (Check(sizeof(value))) {
+            memcpy(&value, mBuffer.data() + mOffset, sizeof(value));
+            mOffset += sizeof(value);
+        }
+    }
+
+    inline void operator()(std::string & value) {
+        unsigned long long size = 0;
+        (*this)(size);
+        if (Check(size)) {
+            value.assign(mBuffer.data() + mOffset, static_cast<size_t>(size));
+            mOffset += static_cast<size_t>(size);
+        }
+    }
+
+    inline void operator()(std::vector<double> & values) {
+        unsigned long long size = 0;
+        (*this)(size);
+        if (Check(size * sizeof(double))) {
+            values.resize(static_cast<size_t>(size));
+            if (size > 0) {
+                memcpy(&(values[0]), mBuffer.data() + mOffset, size * sizeof(double));
+            }
+            mOffset += static_cast<size_t>(size * sizeof(double));
+        }
+    }
+
+    template <class _enum>
+    inline void Enum(_enum & value) {
+        int integer = 0;
+        (*this)(integer);
+        value = static_cast<_enum>(integer);
+    }
+
+    //! True if all reads succeeded and the whole buffer was used
+    inline bool Valid(void) const {
+        return mValid && (mOffset == mBuffer.size());
+    }
+
+protected:
+    inline bool Check(const unsigned long long size) {
+        if (!mValid || (size > mBuffer.size() - mOffset)) {
+            mValid = false;
+        }
+        return mValid;
+    }
+
+    const std::string & mBuffer;
+    size_t mOffset;
+    bool mValid;
+};
+
+template <class _archive>
+static void osaPIDConfigurationSerialize(_archive & archive, osaPIDConfiguration & configuration)
+{
+    archive(configuration.StateTableSize);
+    archive(configuration.ConfigurationStateTableSize);
+    archive(configuration.NumberOfActiveJoints);
+    archive.Enum(configuration.Interpolation);
+    archive(configuration.InterpolationMaxInterval);
+    archive(configuration.TelemetryBufferDuration);
+    archive(configuration.EventMinimumInterval);
+    archive(configuration.SimulationSubStep);
+
+    unsigned long long numberOfJoints = configuration.Joints.size();
+    archive(numberOfJoints);
+    // invalid size, don't allocate and let the reader fail on the remaining data
+    if (numberOfJoints > 65536) {
+        numberOfJoints = 0;
+    }
+    configuration.Joints.resize(static_cast<size_t>(numberOfJoints));
+    for (size_t index = 0; index < configuration.Joints.size(); ++index) {
+        osaPIDConfiguration::Joint & joint = configuration.Joints[index];
+        archive.Enum(joint.Type);
+        archive(joint.Name);
+        archive(joint.PGain);
+        archive(joint.DGain);
+        archive(joint.IGain);
+        archive(joint.OffsetTorque);
+        archive(joint.Forget);
+        archive(joint.Nonlinear);
+        archive(joint.VelocityFeedForward);
+        archive(joint.AccelerationFeedForward);
+        archive(joint.MinILimit);
+        archive(joint.MaxILimit);
+        archive(joint.ErrorLimit);
+        archive(joint.Deadband);
+        archive.Enum(joint.VelocityFilter);
+        archive(joint.VelocityCutoff);
+        archive(joint.VelocityNoiseLevel);
+        archive(joint.VelocityWindow);
+        archive(joint.VelocityOrder);
+        archive.Enum(joint.DerivativeFilter);
+        archive(joint.DerivativeCutoff);
+        archive(joint.DerivativeProcessNoise);
+        archive(joint.DerivativeMeasurementNoise);
+        archive(joint.HasTrajectoryLimits);
+        archive(joint.MaxVelocity);
+        archive(joint.MaxAcceleration);
+        archive(joint.MaxJerk);
+        archive(joint.HasPositionLimits);
+        archive(joint.PositionLowerLimit);
+        archive(joint.PositionUpperLimit);
+        archive(joint.PlantMass);
+        archive(joint.PlantDamping);
+        archive(joint.PlantFriction);
+        archive(joint.PlantBacklash);
+        archive.Enum(joint.ScheduleVariable);
+        archive(joint.ScheduleValues);
+        archive(joint.SchedulePGains);
+        archive(joint.ScheduleIGains);
+        archive(joint.ScheduleDGains);
+    }
+}
+
+osaPIDConfiguration::Joint::Joint(void):
+    Type(PRM_INACTIVE),
+    PGain(0.0),
+    DGain(0.0),
+    IGain(0.0),
+    OffsetTorque(0.0),
+    Forget(1.0),
+    Nonlinear(0.0),
+    VelocityFeedForward(0.0),
+    AccelerationFeedForward(0.0),
+    MinILimit(cmnTypeTraits<double>::MinNegativeValue()),
+    MaxILimit(cmnTypeTraits<double>::MaxPositiveValue()),
+    ErrorLimit(0.0),
+    Deadband(0.0),
+    VelocityFilter(osaVelocityEstimator::FINITE_DIFFERENCE),
+    VelocityCutoff(0.0),
+    VelocityNoiseLevel(0.0),
+    VelocityWindow(0),
+    VelocityOrder(0),
+    DerivativeFilter(osaDerivativeFilter::NONE),
+    DerivativeCutoff(0.0),
+    DerivativeProcessNoise(0.0),
+    DerivativeMeasurementNoise(0.0),
+    HasTrajectoryLimits(false),
+    MaxVelocity(0.0),
+    MaxAcceleration(0.0),
+    MaxJerk(0.0),
+    HasPositionLimits(false),
+    PositionLowerLimit(0.0),
+    PositionUpperLimit(0.0),
+    PlantMass(1.0),
+    PlantDamping(0.0),
+    PlantFriction(0.0),
+    PlantBacklash(0.0),
+    ScheduleVariable(osaGainSchedule::NONE)
+{
+}
+
+osaPIDConfiguration::osaPIDConfiguration(void):
+    StateTableSize(0),
+    ConfigurationStateTableSize(0),
+    NumberOfActiveJoints(0),
+    Interpolation(osaSetpointInterpolator::NONE),
+    InterpolationMaxInterval(0.1),
+    TelemetryBufferDuration(2.0),
+    EventMinimumInterval(0.5),
+    SimulationSubStep(0.1e-3)
+{
+}
+
+bool osaPIDConfiguration::LoadXML(const std::string & filename)
+{
+    cmnXMLPath config;
+    config.SetInputSource(filename);
+
+    // history depth, 0 to keep current size
+    config.GetXMLValue("/controller", "statetable/@Size", StateTableSize, 0);
+    config.GetXMLValue("/controller", "statetable/@ConfigurationSize", ConfigurationStateTableSize, 0);
+    if (((StateTableSize != 0) && (StateTableSize < 2))
+        || ((ConfigurationStateTableSize != 0) && (ConfigurationStateTableSize < 2))) {
+        CMN_LOG_INIT_ERROR << "osaPIDConfiguration::LoadXML: state table sizes must be at least 2" << std::endl;
+        return false;
+    }
+
+    // check type, interface and number of joints
+    std::string type, interface;
+    config.GetXMLValue("/controller", "@type", type, "");
+    config.GetXMLValue("/controller", "@interface", interface, "");
+    int numberOfJoints;
+    config.GetXMLValue("/controller", "@numofjoints", numberOfJoints, -1);
+    if (type != "PID") {
+        CMN_LOG_INIT_ERROR << "osaPIDConfiguration::LoadXML: wrong controller type" << std::endl;
+        return false;
+    } else if (interface != "JointTorqueInterface") {
+        CMN_LOG_INIT_ERROR << "osaPIDConfiguration::LoadXML: wrong interface. Require JointTorqueInterface" << std::endl;
+        return false;
+    } else if (numberOfJoints < 0) {
+        CMN_LOG_INIT_ERROR << "osaPIDConfiguration::LoadXML: invalid number of joints" << std::endl;
+        return false;
+    }
+    Joints.assign(numberOfJoints, Joint());
+    NumberOfActiveJoints = 0;
+    bool hasInactiveJoints = false;
+
+    char context[64];
+
+    // first loop to find inactive joints
+    for (int i = 0; i < numberOfJoints; i++) {
+        sprintf(context, "controller/joints/joint[%d]", i + 1);
+        Joint & joint = Joints[i];
+        std::string jointType;
+        config.GetXMLValue(context, "@type", jointType);
+        if (jointType == "Revolute") {
+            joint.Type = PRM_REVOLUTE;
+        } else if (jointType == "Prismatic") {
+            joint.Type = PRM_PRISMATIC;
+        } else if (jointType == "Inactive") {
+            joint.Type = PRM_INACTIVE;
+        } else {
+            CMN_LOG_INIT_ERROR << "osaPIDConfiguration::LoadXML: joint " << i << " in file: "
+                               << filename
+                               << " needs a \"type\", either \"Revolute\" or \"Prismatic\""
+                               << std::endl;
+            return false;
+        }
+
+        if (joint.Type == PRM_INACTIVE) {
+            hasInactiveJoints = true;
+        } else {
+            // we found an inactive joint after an active one, this is not supported
+            if (hasInactiveJoints) {
+                CMN_LOG_INIT_ERROR << "osaPIDConfiguration::LoadXML: joint " << i << " in file: "
+                                   << filename
+                                   << " has is not \"Inactive\" but is defined after an \"Inactive\" joint, this is not supported"
+                                   << std::endl;
+                return false;
+            }
+            NumberOfActiveJoints++;
+        }
+    }
+
+    // loop to get configuration data except type
+    for (size_t i = 0; i < NumberOfActiveJoints; i++) {
+        sprintf(context, "controller/joints/joint[%d]", static_cast<int>(i + 1));
+        Joint & joint = Joints[i];
+
+        config.GetXMLValue(context, "@name", joint.Name);
+
+        // pid
+        config.GetXMLValue(context, "pid/@PGain", joint.PGain);
+        config.GetXMLValue(context, "pid/@DGain", joint.DGain);
+        config.GetXMLValue(context, "pid/@IGain", joint.IGain);
+        config.GetXMLValue(context, "pid/@OffsetTorque", joint.OffsetTorque);
+        config.GetXMLValue(context, "pid/@Forget", joint.Forget);
+        config.GetXMLValue(context, "pid/@Nonlinear", joint.Nonlinear);
+        config.GetXMLValue(context, "pid/@VelocityFeedForward", joint.VelocityFeedForward, 0.0);
+        config.GetXMLValue(context, "pid/@AccelerationFeedForward", joint.AccelerationFeedForward, 0.0);
+
+        // limit
+        config.GetXMLValue(context, "limit/@MinILimit", joint.MinILimit);
+        config.GetXMLValue(context, "limit/@MaxILimit", joint.MaxILimit);
+        config.GetXMLValue(context, "limit/@ErrorLimit", joint.ErrorLimit);
+        config.GetXMLValue(context, "limit/@Deadband", joint.Deadband);
+
+        // velocity estimation, only used if IO doesn't provide velocities
+        std::string filter;
+        config.GetXMLValue(context, "velocity/@Filter", filter, "FiniteDifference");
+        if (filter == "FiniteDifference") {
+            joint.VelocityFilter = osaVelocityEstimator::FINITE_DIFFERENCE;
+        } else if (filter == "LowPass") {
+            joint.VelocityFilter = osaVelocityEstimator::LOW_PASS;
+            config.GetXMLValue(context, "velocity/@Cutoff", joint.VelocityCutoff, 0.0);
+        } else if (filter == "SavitzkyGolay") {
+            joint.VelocityFilter = osaVelocityEstimator::SAVITZKY_GOLAY;
+            config.GetXMLValue(context, "velocity/@Window", joint.VelocityWindow, 5);
+            config.GetXMLValue(context, "velocity/@Order", joint.VelocityOrder, 2);
+        } else if (filter == "AdaptiveWindow") {
+            joint.VelocityFilter = osaVelocityEstimator::ADAPTIVE_WINDOW;
+            config.GetXMLValue(context, "velocity/@Window", joint.VelocityWindow, 16);
+            config.GetXMLValue(context, "velocity/@NoiseLevel", joint.VelocityNoiseLevel, 0.0);
+        } else {
+            CMN_LOG_INIT_ERROR << "osaPIDConfiguration::LoadXML: joint " << i << " in file: "
+                               << filename
+                               << " velocity \"Filter\" must be \"FiniteDifference\", \"LowPass\", \"SavitzkyGolay\" or \"AdaptiveWindow\""
+                               << std::endl;
+            return false;
+        }
+        if ((joint.VelocityWindow < 0) || (joint.VelocityOrder < 0)) {
+            CMN_LOG_INIT_ERROR << "osaPIDConfiguration::LoadXML: joint " << i << " in file: "
+                               << filename
+                               << " has a negative velocity Window or Order" << std::endl;
+            return false;
+        }
+
+        // filter for derivative term, coefficients depend on period
+        config.GetXMLValue(context, "derivative/@Filter", filter, "None");
+        if (filter == "None") {
+            joint.DerivativeFilter = osaDerivativeFilter::NONE;
+        } else if (filter == "Butterworth") {
+            joint.DerivativeFilter = osaDerivativeFilter::BUTTERWORTH;
+            config.GetXMLValue(context, "derivative/@Cutoff", joint.DerivativeCutoff, 0.0);
+        } else if (filter == "Tustin") {
+            joint.DerivativeFilter = osaDerivativeFilter::TUSTIN;
+            config.GetXMLValue(context, "derivative/@Cutoff", joint.DerivativeCutoff, 0.0);
+        } else if (filter == "Observer") {
+            joint.DerivativeFilter = osaDerivativeFilter::OBSERVER;
+            config.GetXMLValue(context, "derivative/@ProcessNoise", joint.DerivativeProcessNoise, 0.0);
+            config.GetXMLValue(context, "derivative/@MeasurementNoise", joint.DerivativeMeasurementNoise, 0.0);
+        } else {
+            CMN_LOG_INIT_ERROR << "osaPIDConfiguration::LoadXML: joint " << i << " in file: "
+                               << filename
+                               << " has an invalid derivative filter, \"Filter\" must be \"None\", \"Butterworth\" (Cutoff), \"Tustin\" (Cutoff) or \"Observer\" (ProcessNoise, MeasurementNoise)"
+                               << std::endl;
+            return false;
+        }
+
+        // trajectory limits for goals, all or none
+        if (config.GetXMLValue(context, "trajectory/@MaxVelocity", joint.MaxVelocity)) {
+            joint.HasTrajectoryLimits = true;
+            config.GetXMLValue(context, "trajectory/@MaxAcceleration", joint.MaxAcceleration, 0.0);
+            config.GetXMLValue(context, "trajectory/@MaxJerk", joint.MaxJerk, 0.0);
+        }
+
+        // joint limit
+        std::string units;
+        if (config.GetXMLValue(context, "pos/@Units", units)) {
+            joint.HasPositionLimits = true;
+            config.GetXMLValue(context, "pos/@LowerLimit", joint.PositionLowerLimit);
+            config.GetXMLValue(context, "pos/@UpperLimit", joint.PositionUpperLimit);
+            if (units == "deg") {
+                joint.PositionLowerLimit *= cmnPI_180;
+                joint.PositionUpperLimit *= cmnPI_180;
+            } else if (units == "mm") {
+                joint.PositionLowerLimit *= cmn_mm;
+                joint.PositionUpperLimit *= cmn_mm;
+            }
+        }
+
+        // simulated plant, only used by mtsPID::SetSimulatedPlant
+        config.GetXMLValue(context, "plant/@Mass", joint.PlantMass, 1.0);
+        config.GetXMLValue(context, "plant/@Damping", joint.PlantDamping, 0.0);
+        config.GetXMLValue(context, "plant/@Friction", joint.PlantFriction, 0.0);
+        config.GetXMLValue(context, "plant/@Backlash", joint.PlantBacklash, 0.0);
+        if (!(joint.PlantMass > 0.0) || (joint.PlantDamping < 0.0)
+            || (joint.PlantFriction < 0.0) || (joint.PlantBacklash < 0.0)) {
+            CMN_LOG_INIT_ERROR << "osaPIDConfiguration::LoadXML: joint " << i << " in file: "
+                               << filename
+                               << " has invalid plant parameters, \"Mass\" must be positive, \"Damping\", \"Friction\" and \"Backlash\" can't be negative"
+                               << std::endl;
+            return false;
+        }
+    }
+
+    if (!ReadGainSchedule(config)) {
+        CMN_LOG_INIT_ERROR << "osaPIDConfiguration::LoadXML: invalid gain schedule in file: "
+                           << filename << std::endl;
+        return false;
+    }
+
+    // interpolation between setpoints
+    std::string interpolation;
+    config.GetXMLValue("/controller", "interpolation/@Type", interpolation, "None");
+    config.GetXMLValue("/controller", "interpolation/@MaxInterval", InterpolationMaxInterval, 0.1);
+    if (interpolation == "None") {
+        Interpolation = osaSetpointInterpolator::NONE;
+    } else if (interpolation == "Linear") {
+        Interpolation = osaSetpointInterpolator::LINEAR;
+    } else if (interpolation == "CubicHermite") {
+        Interpolation = osaSetpointInterpolator::CUBIC_HERMITE;
+    } else if (interpolation == "Quintic") {
+        Interpolation = osaSetpointInterpolator::QUINTIC;
+    } else {
+        CMN_LOG_INIT_ERROR << "osaPIDConfiguration::LoadXML: interpolation \"Type\" must be \"None\", \"Linear\", \"CubicHermite\" or \"Quintic\"" << std::endl;
+        return false;
+    }
+
+    config.GetXMLValue("/controller", "telemetry/@BufferDuration", TelemetryBufferDuration, 2.0);
+    config.GetXMLValue("/controller", "events/@MinimumInterval", EventMinimumInterval, 0.5);
+    config.GetXMLValue("/controller", "simulation/@SubStep", SimulationSubStep, 0.1e-3);
+    if (!(SimulationSubStep > 0.0)) {
+        CMN_LOG_INIT_ERROR << "osaPIDConfiguration::LoadXML: simulation \"SubStep\" must be positive" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool osaPIDConfiguration::LoadGainScheduleXML(const std::string & filename)
+{
+    cmnXMLPath config;
+    config.SetInputSource(filename);
+    return ReadGainSchedule(config);
+}
+
+bool osaPIDConfiguration::ReadGainSchedule(cmnXMLPath & config)
+{
+    char context[64];
+    char pointContext[128];
+    for (size_t i = 0; i < NumberOfActiveJoints; ++i) {
+        sprintf(context, "controller/joints/joint[%d]", static_cast<int>(i + 1));
+        Joint & joint = Joints[i];
+        joint.ScheduleVariable = osaGainSchedule::NONE;
+        joint.ScheduleValues.clear();
+        joint.SchedulePGains.clear();
+        joint.ScheduleIGains.clear();
+        joint.ScheduleDGains.clear();
+        std::string variable;
+        if (!config.GetXMLValue(context, "schedule/@Variable", variable)) {
+            continue;
+        }
+        if (variable == "Position") {
+            joint.ScheduleVariable = osaGainSchedule::POSITION;
+        } else if (variable == "User") {
+            joint.ScheduleVariable = osaGainSchedule::USER;
+        } else {
+            CMN_LOG_INIT_ERROR << "osaPIDConfiguration::ReadGainSchedule: joint " << i
+                               << ", schedule \"Variable\" must be \"Position\" or \"User\"" << std::endl;
+            return false;
+        }
+        for (int point = 1; ; ++point) {
+            sprintf(pointContext, "%s/schedule/point[%d]", context, point);
+            double value, pGain, iGain, dGain;
+            if (!config.GetXMLValue(pointContext, "@Value", value)) {
+                break;
+            }
+            if (!config.GetXMLValue(pointContext, "@PGain", pGain)
+                || !config.GetXMLValue(pointContext, "@IGain", iGain)
+                || !config.GetXMLValue(pointContext, "@DGain", dGain)) {
+                CMN_LOG_INIT_ERROR << "osaPIDConfiguration::ReadGainSchedule: joint " << i << ", point " << point
+                                   << " must define \"PGain\", \"IGain\" and \"DGain\"" << std::endl;
+                return false;
+            }
+            joint.ScheduleValues.push_back(value);
+            joint.SchedulePGains.push_back(pGain);
+            joint.ScheduleIGains.push_back(iGain);
+            joint.ScheduleDGains.push_back(dGain);
+        }
+    }
+    // check now so LoadXML fails on invalid tables
+    osaGainSchedule::Table table;
+    return GainSchedule(table);
+}
+
+bool osaPIDConfiguration::GainSchedule(osaGainSchedule::Table & table) const
+{
+    table.SetSize(NumberOfActiveJoints);
+    for (size_t i = 0; i < NumberOfActiveJoints; ++i) {
+        const Joint & joint = Joints[i];
+        if (joint.ScheduleVariable == osaGainSchedule::NONE) {
+            continue;
+        }
+        if (!table.SetJoint(i, joint.ScheduleVariable, joint.ScheduleValues,
+                            joint.SchedulePGains, joint.ScheduleIGains, joint.ScheduleDGains)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void osaPIDConfiguration::ToBinary(std::string & buffer) const
+{
+    osaPIDConfigurationWriter writer(buffer);
+    // the serialization list is shared with FromBinary, the writer doesn't modify data
+    osaPIDConfigurationSerialize(writer, const_cast<osaPIDConfiguration &>(*this));
+}
+
+bool osaPIDConfiguration::FromBinary(const std::string & buffer)
+{
+    osaPIDConfigurationReader reader(buffer);
+    osaPIDConfigurationSerialize(reader, *this);
+    return reader.Valid() && (NumberOfActiveJoints <= Joints.size());
+}
+
+bool osaPIDConfiguration::SaveCompiled(const std::string & filename, const unsigned long long xmlHash) const
+{
+    std::string payload;
+    ToBinary(payload);
+    const unsigned long long header[4] = {VERSION,
+                                          xmlHash,
+                                          payload.size(),
+                                          osaPIDConfigurationHash(payload.data(), payload.size())};
+
+    // write to a temporary file and rename so other processes never
+    // read a partial file
+    std::stringstream temporary;
+    temporary << filename << "." << static_cast<unsigned long long>(osaGetTime() * 1.0e9) << ".tmp";
+    {
+        std::ofstream file(temporary.str().c_str(), std::ios::binary | std::ios::trunc);
+        if (!file.good()) {
+            CMN_LOG_INIT_WARNING << "osaPIDConfiguration::SaveCompiled: can't open " << temporary.str() << std::endl;
+            return false;
+        }
+        file.write(osaPIDConfigurationMagic, sizeof(osaPIDConfigurationMagic));
+        file.write(reinterpret_cast<const char *>(header), sizeof(header));
+        file.write(payload.data(), payload.size());
+        if (!file.good()) {
+            file.close();
+            std::remove(temporary.str().c_str());
+            CMN_LOG_INIT_WARNING << "osaPIDConfiguration::SaveCompiled: failed to write " << temporary.str() << std::endl;
+            return false;
+        }
+    }
+    if (std::rename(temporary.str().c_str(), filename.c_str()) != 0) {
+        // some platforms don't replace existing files
+        std::remove(filename.c_str());
+        if (std::rename(temporary.str().c_str(), filename.c_str()) != 0) {
+            std::remove(temporary.str().c_str());
+            CMN_LOG_INIT_WARNING << "osaPIDConfiguration::SaveCompiled: can't rename to " << filename << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool osaPIDConfiguration::LoadCompiled(const std::string & filename, const unsigned long long xmlHash)
+{
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file.good()) {
+        return false;
+    }
+    const std::string content((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+    unsigned long long header[4];
+    const size_t headerSize = sizeof(osaPIDConfigurationMagic) + sizeof(header);
+    if ((content.size() < headerSize)
+        || (memcmp(content.data(), osaPIDConfigurationMagic, sizeof(osaPIDConfigurationMagic)) != 0)) {
+        CMN_LOG_INIT_WARNING << "osaPIDConfiguration::LoadCompiled: " << filename
+                             << " is not a compiled configuration file" << std::endl;
+        return false;
+    }
+    memcpy(header, content.data() + sizeof(osaPIDConfigurationMagic), sizeof(header));
+    // stale, i.e. different format or XML file modified since
+    if ((header[0] != VERSION) || (header[1] != xmlHash)) {
+        return false;
+    }
+    if ((header[2] != content.size() - headerSize)
+        || (header[3] != osaPIDConfigurationHash(content.data() + headerSize, content.size() - headerSize))) {
+        CMN_LOG_INIT_WARNING << "osaPIDConfiguration::LoadCompiled: " << filename
+                             << " is corrupted" << std::endl;
+        return false;
+    }
+    osaPIDConfiguration configuration;
+    if (!configuration.FromBinary(content.substr(headerSize))) {
+        CMN_LOG_INIT_WARNING << "osaPIDConfiguration::LoadCompiled: " << filename
+                             << " is invalid" << std::endl;
+        return false;
+    }
+    *this = configuration;
+    return true;
+}
+
+bool osaPIDConfiguration::FileHash(const std::string & filename, unsigned long long & hash)
+{
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file.good()) {
+        return false;
+    }
+    const std::string content((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+    hash = osaPIDConfigurationHash(content.data(), content.size());
+    return true;
+}
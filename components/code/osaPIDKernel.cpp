@@ -0,0 +1,188 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cmath>
+
+#include <cisstCommon/cmnTypeTraits.h>
+#include <sawControllers/osaPIDKernel.h>
+
+// 64 bytes cache line
+#define OSA_PID_KERNEL_ALIGNMENT 8
+
+osaPIDKernel::osaPIDKernel(void):
+    mSize(0),
+    mStride(0),
+    mData(0)
+{
+}
+
+void osaPIDKernel::SetSize(const size_t numberOfJoints)
+{
+    mSize = numberOfJoints;
+    // round up to a full cache line
+    mStride = ((numberOfJoints + OSA_PID_KERNEL_ALIGNMENT - 1) / OSA_PID_KERNEL_ALIGNMENT)
+        * OSA_PID_KERNEL_ALIGNMENT;
+    mBlock.SetSize(NUMBER_OF_FIELDS * mStride + OSA_PID_KERNEL_ALIGNMENT, 0.0);
+    // align first element
+    const size_t alignmentInBytes = OSA_PID_KERNEL_ALIGNMENT * sizeof(double);
+    const size_t address = reinterpret_cast<size_t>(mBlock.Pointer());
+    const size_t misalignment = address % alignmentInBytes;
+    mData = mBlock.Pointer();
+    if (misalignment != 0) {
+        mData += (alignmentInBytes - misalignment) / sizeof(double);
+    }
+    // defaults with no effect
+    Field(IERROR_LIMIT_MIN).SetAll(cmnTypeTraits<double>::MinNegativeValue());
+    Field(IERROR_LIMIT_MAX).SetAll(cmnTypeTraits<double>::MaxPositiveValue());
+    Field(IERROR_FORGET_FACTOR).SetAll(1.0);
+}
+
+void osaPIDKernel::Reset(const size_t first, const size_t count)
+{
+    Field(POSITION_ERROR, first, count).SetAll(0.0);
+    Field(INTEGRAL_ERROR, first, count).SetAll(0.0);
+    Field(TRACKING_ERROR, first, count).SetAll(0.0);
+    Field(PREVIOUS_TRACKING_ERROR, first, count).SetAll(0.0);
+    Field(TRACKING_ERROR_NOW, first, count).SetAll(0.0);
+    Field(TRACKING_ERROR_NEW, first, count).SetAll(0.0);
+}
+
+bool osaPIDKernel::TrackingError(const size_t first, const size_t count,
+                                 bool & newTrackingError) const
+{
+    const double * trackingErrorNow = Pointer(TRACKING_ERROR_NOW);
+    const double * trackingErrorNew = Pointer(TRACKING_ERROR_NEW);
+    double anyTrackingErrorSum = 0.0;
+    double newTrackingErrorSum = 0.0;
+    const size_t end = first + count;
+    for (size_t i = first; i < end; ++i) {
+        anyTrackingErrorSum += trackingErrorNow[i];
+        newTrackingErrorSum += trackingErrorNew[i];
+    }
+    newTrackingError = (newTrackingErrorSum > 0.0);
+    return (anyTrackingErrorSum > 0.0);
+}
+
+bool osaPIDKernel::Evaluate(const size_t first, const size_t count,
+                            bool & newTrackingError)
+{
+    const double * kP = Pointer(KP);
+    const double * kI = Pointer(KI);
+    const double * kD = Pointer(KD);
+    const double * offset = Pointer(OFFSET);
+    const double * deadBand = Pointer(DEADBAND);
+    const double * iErrorLimitMin = Pointer(IERROR_LIMIT_MIN);
+    const double * iErrorLimitMax = Pointer(IERROR_LIMIT_MAX);
+    const double * iErrorForgetFactor = Pointer(IERROR_FORGET_FACTOR);
+    const double * nonLinear = Pointer(NONLINEAR);
+    const double * effortLowerLimit = Pointer(EFFORT_LOWER_LIMIT);
+    const double * effortUpperLimit = Pointer(EFFORT_UPPER_LIMIT);
+    const double * tolerance = Pointer(TRACKING_ERROR_TOLERANCE);
+    const double * kVelocityFeedForward = Pointer(VELOCITY_FEEDFORWARD);
+    const double * kAccelerationFeedForward = Pointer(ACCELERATION_FEEDFORWARD);
+    const double * enabled = Pointer(ENABLED);
+    const double * effortMode = Pointer(EFFORT_MODE);
+    const double * trackingErrorEnabled = Pointer(TRACKING_ERROR_ENABLED);
+    const double * applyEffortLimit = Pointer(APPLY_EFFORT_LIMIT);
+    const double * positionLimit = Pointer(POSITION_LIMIT);
+    const double * measurePosition = Pointer(MEASURED_POSITION);
+    const double * measureVelocity = Pointer(MEASURED_VELOCITY);
+    const double * effortUserCommand = Pointer(USER_EFFORT);
+    const double * commandVelocity = Pointer(COMMAND_VELOCITY);
+    const double * commandAcceleration = Pointer(COMMAND_ACCELERATION);
+    const double * feedForwardEffort = Pointer(FEEDFORWARD_EFFORT);
+    double * commandPosition = Pointer(COMMAND_POSITION);
+    double * commandEffort = Pointer(COMMAND_EFFORT);
+    double * positionError = Pointer(POSITION_ERROR);
+    double * iError = Pointer(INTEGRAL_ERROR);
+    double * trackingError = Pointer(TRACKING_ERROR);
+    double * previousTrackingError = Pointer(PREVIOUS_TRACKING_ERROR);
+    double * trackingErrorNow = Pointer(TRACKING_ERROR_NOW);
+    double * trackingErrorNew = Pointer(TRACKING_ERROR_NEW);
+
+    // use sums instead of booleans so the loop can be vectorized
+    double anyTrackingErrorSum = 0.0;
+    double newTrackingErrorSum = 0.0;
+
+    const size_t end = first + count;
+    for (size_t i = first; i < end; ++i) {
+        // PID is active if joint is enabled and not in effort mode
+        const bool isEnabled = (enabled[i] != 0.0);
+        const bool isEffortMode = (effortMode[i] != 0.0);
+        const bool isActive = isEnabled && !isEffortMode;
+
+        // error with dead band
+        const double rawError = commandPosition[i] - measurePosition[i];
+        const bool inDeadBand = (fabs(rawError) <= deadBand[i]);
+        const double error = inDeadBand ? 0.0 : rawError;
+        const double absError = fabs(error);
+
+        // tracking errors, only if active and ignored if the last
+        // request was outside joint limit
+        const bool checkTracking = isActive && (trackingErrorEnabled[i] != 0.0);
+        const bool isTrackingError = checkTracking
+            && (absError > tolerance[i])
+            && (positionLimit[i] == 0.0);
+        const double trackingErrorValue = isTrackingError ? 1.0 : 0.0;
+        const bool wasTrackingError = (previousTrackingError[i] != 0.0);
+        const double newTrackingErrorValue = (isTrackingError && !wasTrackingError) ? 1.0 : 0.0;
+        anyTrackingErrorSum += trackingErrorValue;
+        newTrackingErrorSum += newTrackingErrorValue;
+        trackingErrorNow[i] = trackingErrorValue;
+        trackingErrorNew[i] = newTrackingErrorValue;
+        trackingError[i] = checkTracking ? trackingErrorValue : trackingError[i];
+        previousTrackingError[i] = checkTracking ? trackingErrorValue : previousTrackingError[i];
+
+        // error integral with forget factor and limits
+        double integral = iError[i] * iErrorForgetFactor[i] + error;
+        integral = (integral > iErrorLimitMax[i]) ? iErrorLimitMax[i]
+            : ((integral < iErrorLimitMin[i]) ? iErrorLimitMin[i] : integral);
+
+        // compute effort, error derivative is commanded - measured velocity
+        double effort = kP[i] * error + kD[i] * (commandVelocity[i] - measureVelocity[i]) + kI[i] * integral;
+
+        // nonlinear control mode
+        const bool isNonLinear = (nonLinear[i] > 0.0) && (absError < nonLinear[i]);
+        const double nonLinearSafe = (nonLinear[i] > 0.0) ? nonLinear[i] : 1.0;
+        effort = isNonLinear ? effort * (absError / nonLinearSafe) : effort;
+
+        // add constant offsets and feed-forward in PID mode only and
+        // after non-linear scaling
+        effort += offset[i]
+            + kVelocityFeedForward[i] * commandVelocity[i]
+            + kAccelerationFeedForward[i] * commandAcceleration[i]
+            + feedForwardEffort[i];
+
+        // effort pass-through
+        effort = isEffortMode ? effortUserCommand[i] : effort;
+
+        // apply effort limits if needed
+        const double limitedEffort = (effort > effortUpperLimit[i]) ? effortUpperLimit[i]
+            : ((effort < effortLowerLimit[i]) ? effortLowerLimit[i] : effort);
+        effort = (applyEffortLimit[i] != 0.0) ? limitedEffort : effort;
+
+        // outputs and state, only updated if active
+        commandEffort[i] = isEnabled ? effort : 0.0;
+        commandPosition[i] = isActive ? commandPosition[i] : measurePosition[i];
+        positionError[i] = isActive ? error : positionError[i];
+        iError[i] = isActive ? integral : iError[i];
+    }
+
+    newTrackingError = (newTrackingErrorSum > 0.0);
+    return (anyTrackingErrorSum > 0.0);
+}
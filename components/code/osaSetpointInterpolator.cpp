@@ -0,0 +1,205 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <sawControllers/osaSetpointInterpolator.h>
+
+osaSetpointInterpolator::osaSetpointInterpolator(void):
+    mType(NONE),
+    mNumberOfJoints(0),
+    mMinInterval(0.0),
+    mMaxInterval(0.0),
+    mGoalTimestamp(0.0),
+    mHasGoal(false),
+    mSegmentStart(0.0),
+    mSegmentDuration(0.0)
+{
+}
+
+void osaSetpointInterpolator::Configure(const size_t numberOfJoints,
+                                        const InterpolationType type,
+                                        const double minInterval,
+                                        const double maxInterval)
+{
+    mType = type;
+    mNumberOfJoints = numberOfJoints;
+    mMinInterval = minInterval;
+    mMaxInterval = maxInterval;
+    mGoal.SetSize(numberOfJoints, 0.0);
+    mGoalVelocity.SetSize(numberOfJoints, 0.0);
+    mPosition.SetSize(numberOfJoints, 0.0);
+    mVelocity.SetSize(numberOfJoints, 0.0);
+    mAcceleration.SetSize(numberOfJoints, 0.0);
+    mCoefficients.SetSize(NUMBER_OF_COEFFICIENTS * numberOfJoints, 0.0);
+    Reset(mPosition);
+}
+
+void osaSetpointInterpolator::Reset(const vctDynamicConstVectorRef<double> & position)
+{
+    mPosition.Assign(position);
+    mVelocity.SetAll(0.0);
+    mAcceleration.SetAll(0.0);
+    mGoal.Assign(position);
+    mGoalVelocity.SetAll(0.0);
+    mHasGoal = false;
+    mSegmentDuration = 0.0;
+}
+
+void osaSetpointInterpolator::SetGoal(const vctDynamicConstVectorRef<double> & goal,
+                                      const vctDynamicConstVectorRef<double> & velocity,
+                                      const double timestamp,
+                                      const double now)
+{
+    const double interval = timestamp - mGoalTimestamp;
+    const bool hasVelocity = (velocity.size() == mNumberOfJoints);
+
+    if (!mHasGoal || (interval > mMaxInterval) || (mType == NONE)) {
+        // first setpoint or after a pause, jump
+        mGoal.Assign(goal);
+        if (hasVelocity) {
+            mGoalVelocity.Assign(velocity);
+        } else {
+            mGoalVelocity.SetAll(0.0);
+        }
+        mGoalTimestamp = timestamp;
+        mHasGoal = true;
+        mPosition.Assign(goal);
+        mVelocity.SetAll(0.0);
+        mAcceleration.SetAll(0.0);
+        mSegmentDuration = 0.0;
+        return;
+    }
+
+    // current reference, on the segment or decelerating past its
+    // end, is the start of the new segment
+    EvaluateReference(now - mSegmentStart, mPosition, mVelocity, mAcceleration);
+
+    const double T = (interval > mMinInterval) ? interval : mMinInterval;
+    const double T2 = T * T;
+    const double T3 = T2 * T;
+    double * c0 = Coefficients(0).Pointer();
+    double * c1 = Coefficients(1).Pointer();
+    double * c2 = Coefficients(2).Pointer();
+    double * c3 = Coefficients(3).Pointer();
+    double * c4 = Coefficients(4).Pointer();
+    double * c5 = Coefficients(5).Pointer();
+
+    for (size_t j = 0; j < mNumberOfJoints; ++j) {
+        const double p0 = mPosition[j];
+        const double v0 = mVelocity[j];
+        const double a0 = mAcceleration[j];
+        const double g = goal[j];
+        // velocity and acceleration at end of segment
+        const double vg = hasVelocity ? velocity[j] : (g - mGoal[j]) / T;
+        const double ag = (vg - mGoalVelocity[j]) / T;
+        const double d = g - p0;
+        c0[j] = p0;
+        switch (mType) {
+        case LINEAR:
+            c1[j] = d / T;
+            c2[j] = c3[j] = c4[j] = c5[j] = 0.0;
+            break;
+        case CUBIC_HERMITE:
+            c1[j] = v0;
+            c2[j] = (3.0 * d - (2.0 * v0 + vg) * T) / T2;
+            c3[j] = (-2.0 * d + (v0 + vg) * T) / T3;
+            c4[j] = c5[j] = 0.0;
+            break;
+        default:
+            c1[j] = v0;
+            c2[j] = 0.5 * a0;
+            c3[j] = (20.0 * d - (8.0 * vg + 12.0 * v0) * T - (3.0 * a0 - ag) * T2) / (2.0 * T3);
+            c4[j] = (-30.0 * d + (14.0 * vg + 16.0 * v0) * T + (3.0 * a0 - 2.0 * ag) * T2) / (2.0 * T3 * T);
+            c5[j] = (12.0 * d - 6.0 * (vg + v0) * T + (ag - a0) * T2) / (2.0 * T3 * T2);
+            break;
+        }
+        mGoalVelocity[j] = vg;
+    }
+    mGoal.Assign(goal);
+    mGoalTimestamp = timestamp;
+    mSegmentStart = now;
+    mSegmentDuration = T;
+}
+
+void osaSetpointInterpolator::Evaluate(const double now,
+                                       vctDynamicVectorRef<double> position,
+                                       vctDynamicVectorRef<double> velocity,
+                                       vctDynamicVectorRef<double> acceleration)
+{
+    EvaluateReference(now - mSegmentStart, position, velocity, acceleration);
+}
+
+void osaSetpointInterpolator::EvaluateReference(const double t,
+                                                vctDynamicVectorRef<double> position,
+                                                vctDynamicVectorRef<double> velocity,
+                                                vctDynamicVectorRef<double> acceleration)
+{
+    EvaluateSegment(t, position, velocity, acceleration);
+    const double elapsed = t - mSegmentDuration;
+    if ((mSegmentDuration <= 0.0) || (elapsed <= 0.0)) {
+        return;
+    }
+    // past the end of segment, no setpoint yet: constant deceleration
+    // from the end velocity to rest over the maximum interval
+    const double ramp = (mMaxInterval > 0.0) ? mMaxInterval : 0.0;
+    double * p = position.Pointer();
+    double * v = velocity.Pointer();
+    double * a = acceleration.Pointer();
+    if (elapsed >= ramp) {
+        for (size_t j = 0; j < mNumberOfJoints; ++j) {
+            p[j] += 0.5 * v[j] * ramp;
+            v[j] = 0.0;
+            a[j] = 0.0;
+        }
+        return;
+    }
+    const double scale = 1.0 - elapsed / ramp;
+    const double distance = elapsed - 0.5 * elapsed * elapsed / ramp;
+    for (size_t j = 0; j < mNumberOfJoints; ++j) {
+        p[j] += v[j] * distance;
+        a[j] = -v[j] / ramp;
+        v[j] *= scale;
+    }
+}
+
+void osaSetpointInterpolator::EvaluateSegment(double t,
+                                              vctDynamicVectorRef<double> position,
+                                              vctDynamicVectorRef<double> velocity,
+                                              vctDynamicVectorRef<double> acceleration)
+{
+    if (mSegmentDuration <= 0.0) {
+        position.Assign(mGoal);
+        velocity.SetAll(0.0);
+        acceleration.SetAll(0.0);
+        return;
+    }
+    t = (t < 0.0) ? 0.0 : ((t > mSegmentDuration) ? mSegmentDuration : t);
+    const double * c0 = Coefficients(0).Pointer();
+    const double * c1 = Coefficients(1).Pointer();
+    const double * c2 = Coefficients(2).Pointer();
+    const double * c3 = Coefficients(3).Pointer();
+    const double * c4 = Coefficients(4).Pointer();
+    const double * c5 = Coefficients(5).Pointer();
+    double * p = position.Pointer();
+    double * v = velocity.Pointer();
+    double * a = acceleration.Pointer();
+    for (size_t j = 0; j < mNumberOfJoints; ++j) {
+        p[j] = c0[j] + t * (c1[j] + t * (c2[j] + t * (c3[j] + t * (c4[j] + t * c5[j]))));
+        v[j] = c1[j] + t * (2.0 * c2[j] + t * (3.0 * c3[j] + t * (4.0 * c4[j] + t * 5.0 * c5[j])));
+        a[j] = 2.0 * c2[j] + t * (6.0 * c3[j] + t * (12.0 * c4[j] + t * 20.0 * c5[j]));
+    }
+}
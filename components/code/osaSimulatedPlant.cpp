@@ -0,0 +1,158 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cmath>
+
+#include <cisstCommon/cmnLogger.h>
+#include <sawControllers/osaSimulatedPlant.h>
+
+osaSimulatedPlant::osaSimulatedPlant(void):
+    mModel(0),
+    mSubStep(0.1e-3),
+    mMaximumDuration(0.1)
+{
+}
+
+void osaSimulatedPlant::SetSize(const size_t numberOfJoints)
+{
+    mMass.SetSize(numberOfJoints, 1.0);
+    mDamping.SetSize(numberOfJoints, 0.0);
+    mFriction.SetSize(numberOfJoints, 0.0);
+    mBacklash.SetSize(numberOfJoints, 0.0);
+    mEffort.SetSize(numberOfJoints, 0.0);
+    mActuatedPosition.SetSize(numberOfJoints, 0.0);
+    mVelocity.SetSize(numberOfJoints, 0.0);
+    mPosition.SetSize(numberOfJoints, 0.0);
+    mNetEffort.SetSize(numberOfJoints, 0.0);
+    mAcceleration.SetSize(numberOfJoints, 0.0);
+}
+
+bool osaSimulatedPlant::SetJoint(const size_t joint, const double mass, const double damping,
+                                 const double friction, const double backlash)
+{
+    if ((joint >= size()) || !(mass > 0.0)
+        || (damping < 0.0) || (friction < 0.0) || (backlash < 0.0)) {
+        CMN_LOG_INIT_ERROR << "osaSimulatedPlant::SetJoint: invalid parameters for joint "
+                           << joint << std::endl;
+        return false;
+    }
+    mMass[joint] = mass;
+    mDamping[joint] = damping;
+    mFriction[joint] = friction;
+    mBacklash[joint] = backlash;
+    return true;
+}
+
+bool osaSimulatedPlant::SetSubStep(const double subStep)
+{
+    if (!(subStep > 0.0)) {
+        CMN_LOG_INIT_ERROR << "osaSimulatedPlant::SetSubStep: sub step must be positive" << std::endl;
+        return false;
+    }
+    mSubStep = subStep;
+    return true;
+}
+
+bool osaSimulatedPlant::SetMaximumDuration(const double duration)
+{
+    if (!(duration > 0.0)) {
+        CMN_LOG_INIT_ERROR << "osaSimulatedPlant::SetMaximumDuration: duration must be positive" << std::endl;
+        return false;
+    }
+    mMaximumDuration = duration;
+    return true;
+}
+
+void osaSimulatedPlant::Reset(const vctDynamicConstVectorRef<double> & position)
+{
+    mPosition.Assign(position);
+    mActuatedPosition.Assign(position);
+    mVelocity.SetAll(0.0);
+}
+
+double osaSimulatedPlant::Step(const double duration)
+{
+    if (!(duration > 0.0)) {
+        return 0.0;
+    }
+    // bounded number of sub steps, the caller reports the clamping
+    const double simulated = (duration > mMaximumDuration) ? mMaximumDuration : duration;
+    const size_t numberOfSteps = static_cast<size_t>(ceil(simulated / mSubStep - 1.0e-9));
+    const double step = simulated / numberOfSteps;
+    for (size_t index = 0; index < numberOfSteps; ++index) {
+        SubStep(step);
+    }
+    return duration - simulated;
+}
+
+void osaSimulatedPlant::SubStep(const double step)
+{
+    const size_t numberOfJoints = size();
+
+    if (mModel) {
+        for (size_t joint = 0; joint < numberOfJoints; ++joint) {
+            const double velocity = mVelocity[joint];
+            const double friction = (velocity > 0.0) ? mFriction[joint]
+                : ((velocity < 0.0) ? -mFriction[joint] : 0.0);
+            mNetEffort[joint] = mEffort[joint] - mDamping[joint] * velocity - friction;
+        }
+        mModel->Evaluate(mActuatedPosition, mVelocity, mNetEffort, mAcceleration);
+    }
+
+    for (size_t joint = 0; joint < numberOfJoints; ++joint) {
+        const double velocity = mVelocity[joint];
+        const double friction = mFriction[joint];
+        double newVelocity;
+        if (mModel) {
+            newVelocity = velocity + step * mAcceleration[joint];
+        } else {
+            const double effort = mEffort[joint];
+            double net;
+            if (velocity > 0.0) {
+                net = effort - friction;
+            } else if (velocity < 0.0) {
+                net = effort + friction;
+            } else if (effort > friction) {
+                net = effort - friction;
+            } else if (effort < -friction) {
+                net = effort + friction;
+            } else {
+                // stuck
+                continue;
+            }
+            // damping is implicit
+            const double ratio = step / mMass[joint];
+            newVelocity = (velocity + ratio * net) / (1.0 + ratio * mDamping[joint]);
+        }
+        // friction stops the joint, it doesn't reverse the velocity
+        if ((friction > 0.0) && (velocity * newVelocity < 0.0)) {
+            newVelocity = 0.0;
+        }
+        mVelocity[joint] = newVelocity;
+        mActuatedPosition[joint] += step * newVelocity;
+
+        // measured side only moves when the play is taken up
+        const double halfPlay = 0.5 * mBacklash[joint];
+        const double offset = mActuatedPosition[joint] - mPosition[joint];
+        if (offset > halfPlay) {
+            mPosition[joint] = mActuatedPosition[joint] - halfPlay;
+        } else if (offset < -halfPlay) {
+            mPosition[joint] = mActuatedPosition[joint] + halfPlay;
+        }
+    }
+}
@@ -0,0 +1,127 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+#include <cisstCommon/cmnLogger.h>
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <sawControllers/osaTelemetryRecorder.h>
+
+static const char osaTelemetryRecorderMagic[8] = "SAWTLM1";
+
+osaTelemetryRecorder::osaTelemetryRecorder(void):
+    mRecording(0),
+    mStopRequested(0),
+    mDropped(0),
+    mFile(0)
+{
+}
+
+osaTelemetryRecorder::~osaTelemetryRecorder()
+{
+    Stop();
+}
+
+void osaTelemetryRecorder::Configure(const std::vector<std::string> & columns,
+                                     const size_t capacity)
+{
+    if (IsRecording()) {
+        CMN_LOG_INIT_ERROR << "osaTelemetryRecorder::Configure: can't configure while recording" << std::endl;
+        return;
+    }
+    mColumns = columns;
+    mRing.Configure(columns.size(), capacity);
+}
+
+bool osaTelemetryRecorder::Start(const std::string & filename)
+{
+    if (IsRecording()) {
+        Stop();
+    }
+    if (RecordSize() == 0) {
+        CMN_LOG_RUN_ERROR << "osaTelemetryRecorder::Start: not configured" << std::endl;
+        return false;
+    }
+    mFile = fopen(filename.c_str(), "wb");
+    if (!mFile) {
+        CMN_LOG_RUN_ERROR << "osaTelemetryRecorder::Start: can't open " << filename << std::endl;
+        return false;
+    }
+
+    // header
+    std::string names;
+    for (size_t i = 0; i < mColumns.size(); ++i) {
+        names.append(mColumns[i]);
+        names.append("\n");
+    }
+    const unsigned long long recordSize = RecordSize();
+    const unsigned long long namesLength = names.size();
+    fwrite(osaTelemetryRecorderMagic, 1, sizeof(osaTelemetryRecorderMagic), mFile);
+    fwrite(&recordSize, sizeof(recordSize), 1, mFile);
+    fwrite(&namesLength, sizeof(namesLength), 1, mFile);
+    fwrite(names.data(), 1, names.size(), mFile);
+
+    // skip records committed while not recording
+    mRing.Skip();
+    mDropped = 0;
+    osaRingBuffer::Store(mStopRequested, 0);
+    osaRingBuffer::Store(mRecording, 1);
+    mThread.Create<osaTelemetryRecorder, int>(this, &osaTelemetryRecorder::Write, 0, "Telemetry");
+    return true;
+}
+
+void osaTelemetryRecorder::Stop(void)
+{
+    if (!IsRecording()) {
+        return;
+    }
+    osaRingBuffer::Store(mRecording, 0);
+    osaRingBuffer::Store(mStopRequested, 1);
+    mThread.Wait();
+    fclose(mFile);
+    mFile = 0;
+    if (mDropped > 0) {
+        CMN_LOG_RUN_WARNING << "osaTelemetryRecorder::Stop: " << mDropped
+                            << " records dropped, ring buffer too small" << std::endl;
+    }
+}
+
+void * osaTelemetryRecorder::Write(int)
+{
+    while (!osaRingBuffer::Load(mStopRequested)) {
+        Drain();
+        osaSleep(10.0 * cmn_ms);
+    }
+    // last records committed before Stop
+    Drain();
+    fflush(mFile);
+    return 0;
+}
+
+void osaTelemetryRecorder::Drain(void)
+{
+    // contiguous records up to the end of the ring buffer
+    size_t count;
+    const double * records = mRing.Peek(count);
+    while (records) {
+        fwrite(records, sizeof(double) * RecordSize(), count, mFile);
+        // release the records to the producer
+        mRing.Release(count);
+        records = mRing.Peek(count);
+    }
+}
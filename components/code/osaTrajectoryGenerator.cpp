@@ -0,0 +1,272 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include <cisstCommon/cmnLogger.h>
+#include <sawControllers/osaTrajectoryGenerator.h>
+
+// constant jerk over duration t
+static inline void osaTrajectoryGeneratorIntegrate(double & p, double & v, double & a,
+                                                   const double jerk, const double t)
+{
+    p += t * (v + t * (0.5 * a + t * jerk / 6.0));
+    v += t * (a + 0.5 * t * jerk);
+    a += t * jerk;
+}
+
+osaTrajectoryGenerator::osaTrajectoryGenerator(void):
+    mNumberOfJoints(0),
+    mActive(false),
+    mStart(0.0),
+    mDuration(0.0)
+{
+}
+
+void osaTrajectoryGenerator::SetSize(const size_t numberOfJoints)
+{
+    mNumberOfJoints = numberOfJoints;
+    mVelocityLimit.SetSize(numberOfJoints, 0.0);
+    mAccelerationLimit.SetSize(numberOfJoints, 0.0);
+    mJerkLimit.SetSize(numberOfJoints, 0.0);
+    mGoal.SetSize(numberOfJoints, 0.0);
+    mJointDuration.SetSize(numberOfJoints, 0.0);
+    mSegmentTime.SetSize(NUMBER_OF_SEGMENTS * numberOfJoints, 0.0);
+    mSegmentJerk.SetSize(NUMBER_OF_SEGMENTS * numberOfJoints, 0.0);
+    mSegmentPosition.SetSize(NUMBER_OF_SEGMENTS * numberOfJoints, 0.0);
+    mSegmentVelocity.SetSize(NUMBER_OF_SEGMENTS * numberOfJoints, 0.0);
+    mSegmentAcceleration.SetSize(NUMBER_OF_SEGMENTS * numberOfJoints, 0.0);
+    mActive = false;
+}
+
+bool osaTrajectoryGenerator::SetLimits(const size_t joint, const double velocity,
+                                       const double acceleration, const double jerk)
+{
+    if ((velocity <= 0.0) || (acceleration <= 0.0) || (jerk <= 0.0)) {
+        CMN_LOG_INIT_ERROR << "osaTrajectoryGenerator::SetLimits: limits for joint "
+                           << joint << " must be positive" << std::endl;
+        return false;
+    }
+    mVelocityLimit[joint] = velocity;
+    mAccelerationLimit[joint] = acceleration;
+    mJerkLimit[joint] = jerk;
+    return true;
+}
+
+bool osaTrajectoryGenerator::HasLimits(void) const
+{
+    return (mNumberOfJoints > 0)
+        && (mVelocityLimit.MinElement() > 0.0)
+        && (mAccelerationLimit.MinElement() > 0.0)
+        && (mJerkLimit.MinElement() > 0.0);
+}
+
+void osaTrajectoryGenerator::VelocityChange(const double v0, const double a0, const double v1,
+                                            const double aMax, const double jMax,
+                                            double * duration, double * jerk)
+{
+    // direction based on velocity reached if acceleration is brought to 0 now
+    const double vStop = v0 + 0.5 * a0 * std::fabs(a0) / jMax;
+    const double s = (v1 >= vStop) ? 1.0 : -1.0;
+    // current acceleration might be above a reduced limit, don't jerk away from it
+    double aPeak = s * std::max(aMax, s * a0);
+    double t1 = std::fabs(aPeak - a0) / jMax;
+    double t3 = std::fabs(aPeak) / jMax;
+    double t2 = (v1 - v0 - 0.5 * (a0 + aPeak) * t1 - 0.5 * aPeak * t3) / aPeak;
+    if (t2 < 0.0) {
+        // peak acceleration not reached
+        aPeak = s * std::sqrt(std::max(0.0, s * (v1 - v0) * jMax + 0.5 * a0 * a0));
+        t1 = std::fabs(aPeak - a0) / jMax;
+        t3 = std::fabs(aPeak) / jMax;
+        t2 = 0.0;
+    }
+    duration[0] = t1;
+    jerk[0] = (aPeak >= a0) ? jMax : -jMax;
+    duration[1] = t2;
+    jerk[1] = 0.0;
+    duration[2] = t3;
+    jerk[2] = -s * jMax;
+}
+
+double osaTrajectoryGenerator::Displacement(const double v0, const double a0, const double vCruise,
+                                            const double aMax, const double jMax,
+                                            Profile & profile, double & displacement)
+{
+    VelocityChange(v0, a0, vCruise, aMax, jMax, profile.Duration, profile.Jerk);
+    profile.Duration[3] = 0.0;
+    profile.Jerk[3] = 0.0;
+    VelocityChange(vCruise, 0.0, 0.0, aMax, jMax, profile.Duration + 4, profile.Jerk + 4);
+    double p = 0.0, v = v0, a = a0, duration = 0.0;
+    for (size_t k = 0; k < NUMBER_OF_SEGMENTS; ++k) {
+        osaTrajectoryGeneratorIntegrate(p, v, a, profile.Jerk[k], profile.Duration[k]);
+        duration += profile.Duration[k];
+    }
+    displacement = p;
+    return duration;
+}
+
+double osaTrajectoryGenerator::ComputeProfile(const double distance, const double v0, const double a0,
+                                              const double vLimit, const double aMax, const double jMax,
+                                              Profile & profile, const bool cruiseOnly)
+{
+    double displacement;
+    // cruise at positive limit
+    double duration = Displacement(v0, a0, vLimit, aMax, jMax, profile, displacement);
+    if (distance >= displacement) {
+        profile.Duration[3] = (distance - displacement) / vLimit;
+        return duration + profile.Duration[3];
+    }
+    // cruise at negative limit
+    duration = Displacement(v0, a0, -vLimit, aMax, jMax, profile, displacement);
+    if (distance <= displacement) {
+        profile.Duration[3] = (displacement - distance) / vLimit;
+        return duration + profile.Duration[3];
+    }
+    if (cruiseOnly) {
+        return 0.0;
+    }
+    // no cruise, find peak velocity, displacement increases with it
+    double low = -vLimit;
+    double high = vLimit;
+    for (size_t i = 0; i < MAX_ITERATIONS; ++i) {
+        const double middle = 0.5 * (low + high);
+        duration = Displacement(v0, a0, middle, aMax, jMax, profile, displacement);
+        if (displacement < distance) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return duration;
+}
+
+bool osaTrajectoryGenerator::SetGoal(const vctDynamicConstVectorRef<double> & goal,
+                                     const vctDynamicConstVectorRef<double> & position,
+                                     const vctDynamicConstVectorRef<double> & velocity,
+                                     const vctDynamicConstVectorRef<double> & acceleration,
+                                     const double now)
+{
+    if (!HasLimits()) {
+        CMN_LOG_RUN_ERROR << "osaTrajectoryGenerator::SetGoal: limits are not set for all joints" << std::endl;
+        return false;
+    }
+
+    mGoal.Assign(goal);
+    Profile profile;
+
+    // time optimal duration for each joint
+    mDuration = 0.0;
+    for (size_t j = 0; j < mNumberOfJoints; ++j) {
+        mJointDuration[j] = ComputeProfile(goal[j] - position[j], velocity[j], acceleration[j],
+                                           mVelocityLimit[j], mAccelerationLimit[j], mJerkLimit[j],
+                                           profile);
+        mDuration = std::max(mDuration, mJointDuration[j]);
+    }
+
+    for (size_t j = 0; j < mNumberOfJoints; ++j) {
+        const double distance = goal[j] - position[j];
+        // lowest cruise velocity that still arrives in time.  If the
+        // limit is not reached, the profile is the time optimal one
+        // so there's no need to compute it
+        double high = mVelocityLimit[j];
+        if ((mJointDuration[j] > 0.0) && (mJointDuration[j] < mDuration)) {
+            double low = 0.0;
+            for (size_t i = 0; i < MAX_ITERATIONS; ++i) {
+                const double middle = 0.5 * (low + high);
+                const double duration = ComputeProfile(distance, velocity[j], acceleration[j],
+                                                       middle, mAccelerationLimit[j], mJerkLimit[j],
+                                                       profile, true);
+                if (duration > mDuration) {
+                    low = middle;
+                } else {
+                    high = middle;
+                    if ((mDuration - duration) < 1.0e-6 * mDuration) {
+                        break;
+                    }
+                }
+            }
+        }
+        mJointDuration[j] = ComputeProfile(distance, velocity[j], acceleration[j],
+                                           high, mAccelerationLimit[j], mJerkLimit[j],
+                                           profile);
+
+        // start time and state for each segment
+        double t = now;
+        double p = position[j];
+        double v = velocity[j];
+        double a = acceleration[j];
+        for (size_t k = 0; k < NUMBER_OF_SEGMENTS; ++k) {
+            const size_t index = Index(k, j);
+            mSegmentTime[index] = t;
+            mSegmentJerk[index] = profile.Jerk[k];
+            mSegmentPosition[index] = p;
+            mSegmentVelocity[index] = v;
+            mSegmentAcceleration[index] = a;
+            osaTrajectoryGeneratorIntegrate(p, v, a, profile.Jerk[k], profile.Duration[k]);
+            t += profile.Duration[k];
+        }
+    }
+
+    mStart = now;
+    mActive = true;
+    return true;
+}
+
+bool osaTrajectoryGenerator::Evaluate(const double now,
+                                      vctDynamicVectorRef<double> position,
+                                      vctDynamicVectorRef<double> velocity,
+                                      vctDynamicVectorRef<double> acceleration)
+{
+    if (!mActive) {
+        return false;
+    }
+    if ((now - mStart) >= mDuration) {
+        position.Assign(mGoal);
+        velocity.SetAll(0.0);
+        acceleration.SetAll(0.0);
+        mActive = false;
+        return true;
+    }
+
+    double * pointerP = position.Pointer();
+    double * pointerV = velocity.Pointer();
+    double * pointerA = acceleration.Pointer();
+    for (size_t j = 0; j < mNumberOfJoints; ++j) {
+        if ((now - mStart) >= mJointDuration[j]) {
+            pointerP[j] = mGoal[j];
+            pointerV[j] = 0.0;
+            pointerA[j] = 0.0;
+            continue;
+        }
+        // last segment started, skips segments with no duration
+        size_t k = NUMBER_OF_SEGMENTS - 1;
+        while ((k > 0) && (now < mSegmentTime[Index(k, j)])) {
+            --k;
+        }
+        const size_t index = Index(k, j);
+        double p = mSegmentPosition[index];
+        double v = mSegmentVelocity[index];
+        double a = mSegmentAcceleration[index];
+        osaTrajectoryGeneratorIntegrate(p, v, a, mSegmentJerk[index], now - mSegmentTime[index]);
+        pointerP[j] = p;
+        pointerV[j] = v;
+        pointerA[j] = a;
+    }
+    return false;
+}
@@ -0,0 +1,262 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include <cisstCommon/cmnConstants.h>
+#include <cisstCommon/cmnLogger.h>
+#include <sawControllers/osaVelocityEstimator.h>
+
+osaVelocityEstimator::osaVelocityEstimator(void):
+    mNumberOfJoints(0),
+    mMaxSavitzkyGolayWindow(0),
+    mHistorySize(2),
+    mHead(0),
+    mNumberOfSamples(0)
+{
+}
+
+void osaVelocityEstimator::SetSize(const size_t numberOfJoints)
+{
+    mNumberOfJoints = numberOfJoints;
+    mFilter.SetSize(numberOfJoints);
+    mFilter.SetAll(FINITE_DIFFERENCE);
+    mTimeConstant.SetSize(numberOfJoints);
+    mTimeConstant.SetAll(0.0);
+    mWindow.SetSize(numberOfJoints);
+    mWindow.SetAll(2);
+    mNoiseLevel.SetSize(numberOfJoints);
+    mNoiseLevel.SetAll(0.0);
+    mJointCoefficients.clear();
+    mJointCoefficients.resize(numberOfJoints);
+    mLowPass.SetSize(numberOfJoints);
+    mSavitzkyGolay.SetSize(numberOfJoints);
+    UpdateHistorySize();
+}
+
+void osaVelocityEstimator::SetFiniteDifference(const size_t joint)
+{
+    mFilter[joint] = FINITE_DIFFERENCE;
+    mTimeConstant[joint] = 0.0;
+    mWindow[joint] = 2;
+    UpdateHistorySize();
+}
+
+void osaVelocityEstimator::SetLowPass(const size_t joint, const double cutoffFrequency)
+{
+    mFilter[joint] = LOW_PASS;
+    mTimeConstant[joint] = (cutoffFrequency > 0.0) ? 1.0 / (2.0 * cmnPI * cutoffFrequency) : 0.0;
+    mWindow[joint] = 2;
+    UpdateHistorySize();
+}
+
+bool osaVelocityEstimator::SetSavitzkyGolay(const size_t joint, const size_t window, const size_t order)
+{
+    if ((order < 1) || (order > MAX_ORDER) || (window < order + 1)) {
+        CMN_LOG_INIT_ERROR << "osaVelocityEstimator::SetSavitzkyGolay: invalid window ("
+                           << window << ") or order (" << order << ") for joint "
+                           << joint << std::endl;
+        return false;
+    }
+
+    // least squares fit of a polynomial over samples at x = 0, -1,
+    // ... -(window - 1), the derivative at x = 0 is the coefficient
+    // of x.  Solve normal equations M z = e1, coefficient for sample
+    // k is then sum of z_m x_k^m.
+    const size_t size = order + 1;
+    double M[MAX_ORDER + 1][MAX_ORDER + 2];
+    for (size_t a = 0; a < size; ++a) {
+        for (size_t b = 0; b < size; ++b) {
+            M[a][b] = 0.0;
+            for (size_t k = 0; k < window; ++k) {
+                M[a][b] += std::pow(-static_cast<double>(k), static_cast<double>(a + b));
+            }
+        }
+        M[a][size] = (a == 1) ? 1.0 : 0.0;
+    }
+    // Gauss-Jordan elimination with partial pivoting
+    for (size_t column = 0; column < size; ++column) {
+        size_t pivot = column;
+        for (size_t row = column + 1; row < size; ++row) {
+            if (std::fabs(M[row][column]) > std::fabs(M[pivot][column])) {
+                pivot = row;
+            }
+        }
+        for (size_t b = 0; b <= size; ++b) {
+            std::swap(M[column][b], M[pivot][b]);
+        }
+        for (size_t row = 0; row < size; ++row) {
+            if (row != column) {
+                const double factor = M[row][column] / M[column][column];
+                for (size_t b = column; b <= size; ++b) {
+                    M[row][b] -= factor * M[column][b];
+                }
+            }
+        }
+    }
+
+    std::vector<double> & coefficients = mJointCoefficients[joint];
+    coefficients.resize(window);
+    for (size_t k = 0; k < window; ++k) {
+        coefficients[k] = 0.0;
+        for (size_t m = 0; m < size; ++m) {
+            coefficients[k] += M[m][size] / M[m][m] * std::pow(-static_cast<double>(k), static_cast<double>(m));
+        }
+    }
+
+    mFilter[joint] = SAVITZKY_GOLAY;
+    mTimeConstant[joint] = 0.0;
+    mWindow[joint] = window;
+    UpdateHistorySize();
+    return true;
+}
+
+bool osaVelocityEstimator::SetAdaptiveWindow(const size_t joint, const size_t maxWindow, const double noiseLevel)
+{
+    if ((maxWindow < 2) || (noiseLevel < 0.0)) {
+        CMN_LOG_INIT_ERROR << "osaVelocityEstimator::SetAdaptiveWindow: invalid window ("
+                           << maxWindow << ") or noise level (" << noiseLevel << ") for joint "
+                           << joint << std::endl;
+        return false;
+    }
+    mFilter[joint] = ADAPTIVE_WINDOW;
+    mTimeConstant[joint] = 0.0;
+    mWindow[joint] = maxWindow;
+    mNoiseLevel[joint] = noiseLevel;
+    UpdateHistorySize();
+    return true;
+}
+
+void osaVelocityEstimator::UpdateHistorySize(void)
+{
+    mHistorySize = 2;
+    mMaxSavitzkyGolayWindow = 0;
+    for (size_t joint = 0; joint < mNumberOfJoints; ++joint) {
+        mHistorySize = std::max(mHistorySize, mWindow[joint]);
+        if (mFilter[joint] == SAVITZKY_GOLAY) {
+            mMaxSavitzkyGolayWindow = std::max(mMaxSavitzkyGolayWindow, mWindow[joint]);
+        }
+    }
+
+    // coefficients padded with zeros up to the largest window
+    mCoefficients.SetSize(mMaxSavitzkyGolayWindow * mNumberOfJoints);
+    mCoefficients.SetAll(0.0);
+    for (size_t joint = 0; joint < mNumberOfJoints; ++joint) {
+        if (mFilter[joint] == SAVITZKY_GOLAY) {
+            const std::vector<double> & coefficients = mJointCoefficients[joint];
+            for (size_t k = 0; k < coefficients.size(); ++k) {
+                mCoefficients[k * mNumberOfJoints + joint] = coefficients[k];
+            }
+        }
+    }
+
+    mPositions.resize(mHistorySize * mNumberOfJoints);
+    mTimestamps.resize(mHistorySize);
+    Reset();
+}
+
+void osaVelocityEstimator::Reset(void)
+{
+    std::fill(mPositions.begin(), mPositions.end(), 0.0);
+    std::fill(mTimestamps.begin(), mTimestamps.end(), 0.0);
+    mHead = 0;
+    mNumberOfSamples = 0;
+    mLowPass.SetAll(0.0);
+    mSavitzkyGolay.SetAll(0.0);
+}
+
+bool osaVelocityEstimator::Estimate(const vctDynamicConstVectorRef<double> & position,
+                                    const double timestamp,
+                                    vctDynamicVectorRef<double> velocity)
+{
+    if ((mNumberOfSamples > 0) && (timestamp <= Timestamp(0))) {
+        velocity.SetAll(0.0);
+        return false;
+    }
+
+    // add sample to ring buffer
+    mHead = (mHead + 1) % mHistorySize;
+    std::copy(position.begin(), position.end(), mPositions.begin() + mHead * mNumberOfJoints);
+    mTimestamps[mHead] = timestamp;
+    if (mNumberOfSamples < mHistorySize) {
+        mNumberOfSamples++;
+    }
+    if (mNumberOfSamples < 2) {
+        velocity.SetAll(0.0);
+        return true;
+    }
+
+    const size_t N = mNumberOfJoints;
+    const double * p0 = &(mPositions[mHead * N]);
+    const double * p1 = &(mPositions[((mHead + mHistorySize - 1) % mHistorySize) * N]);
+    const double dt = timestamp - Timestamp(1);
+
+    // finite differences and low pass, time constant is 0 for all
+    // other filters so this is also the fallback for the other filters
+    double * lowPass = mLowPass.Pointer();
+    const double * tau = mTimeConstant.Pointer();
+    double * result = velocity.Pointer();
+    for (size_t j = 0; j < N; ++j) {
+        const double difference = (p0[j] - p1[j]) / dt;
+        lowPass[j] += dt / (dt + tau[j]) * (difference - lowPass[j]);
+        result[j] = lowPass[j];
+    }
+
+    // Savitzky-Golay, one pass per sample over all joints
+    if (mMaxSavitzkyGolayWindow > 0) {
+        double * sum = mSavitzkyGolay.Pointer();
+        mSavitzkyGolay.SetAll(0.0);
+        const size_t window = std::min(mMaxSavitzkyGolayWindow, mNumberOfSamples);
+        for (size_t k = 0; k < window; ++k) {
+            const double * pk = &(Position(k, 0));
+            const double * ck = mCoefficients.Pointer(k * N);
+            for (size_t j = 0; j < N; ++j) {
+                sum[j] += ck[j] * pk[j];
+            }
+        }
+        for (size_t j = 0; j < N; ++j) {
+            if ((mFilter[j] == SAVITZKY_GOLAY) && (mNumberOfSamples >= mWindow[j])) {
+                // coefficients assume unit spacing, use mean spacing over window
+                const size_t last = mWindow[j] - 1;
+                result[j] = sum[j] * last / (timestamp - Timestamp(last));
+            }
+        }
+    }
+
+    // adaptive window, starts from finite difference
+    for (size_t j = 0; j < N; ++j) {
+        if (mFilter[j] != ADAPTIVE_WINDOW) {
+            continue;
+        }
+        const size_t maxN = std::min(mWindow[j], mNumberOfSamples) - 1;
+        for (size_t n = 2; n <= maxN; ++n) {
+            const double slope = (p0[j] - Position(n, j)) / (timestamp - Timestamp(n));
+            bool fits = true;
+            for (size_t i = 1; fits && (i < n); ++i) {
+                const double predicted = p0[j] - slope * (timestamp - Timestamp(i));
+                fits = (std::fabs(Position(i, j) - predicted) <= mNoiseLevel[j]);
+            }
+            if (!fits) {
+                break;
+            }
+            result[j] = slope;
+        }
+    }
+    return true;
+}
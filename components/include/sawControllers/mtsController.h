@@ -1,9 +1,9 @@
-
 #ifndef _mtsController_h
 #define _mtsController_h
 
 #include <cisstOSAbstraction/osaCPUAffinity.h>
 #include <cisstMultiTask/mtsTaskPeriodic.h>
+#include <sawControllers/osaLoopTiming.h>
 #include <sawControllers/sawControllersExport.h>
 
 class CISST_EXPORT mtsController : public mtsTaskPeriodic {
@@ -12,22 +12,81 @@ class CISST_EXPORT mtsController : public mtsTaskPeriodic {
 
   osaCPUMask cpumask;
 
+  //! SCHED_FIFO priority of the task thread, 0 to keep the default policy
+  int priority;
+
+  //! Lock the process memory (mlockall)
+  bool lockmemory;
+
+  //! Number of bytes of heap touched at startup, the stack is
+  //! touched up to MaxStackPrefault bytes
+  size_t prefault;
+
+  //! Stack touched at startup, task threads have small stacks
+  enum { MaxStackPrefault = 64 * 1024 };
+
   mtsInterfaceProvided* ctl;
 
   mtsBool mtsEnabled;
 
+  //! Compute/IO/jitter histograms, read with GetLoopTiming
+  osaLoopTiming looptiming;
+
+  //! Event sent with the loop timing summary, once per second
+  mtsFunctionWrite LoopTimingEvent;
+
  protected:
 
   bool IsEnabled() const { return mtsEnabled; }
 
+  //! Read the real-time settings from an XML file
+  /**
+     All attributes are optional:
+     \code
+     <controller>
+       <realtime cpu="3" priority="80" lockmemory="true" prefault="1048576"/>
+     </controller>
+     \endcode
+     cpu is the index of the core, starting at 0, it overrides the
+     cpumask given to the constructor.
+  */
+  void ConfigureRealTime( const std::string& filename );
+
  public:
 
+  //! Main constructor
+  /**
+     \param[in] taskname   The name of the MTS periodic task
+     \param     period     The period of the task
+     \param     cpumask    The mask of the allowed CPU for the task
+     \param     priority   SCHED_FIFO priority, 0 to keep the default policy
+     \param     lockmemory Lock the process memory
+     \param     prefault   Number of bytes of heap to touch, the stack is
+                           touched up to MaxStackPrefault bytes
+  */
   mtsController( const std::string& taskname,
 		 double period,
-		 osaCPUMask cpumask = OSA_CPUANY );
+		 osaCPUMask cpumask = OSA_CPUANY,
+		 int priority = 0,
+		 bool lockmemory = false,
+		 size_t prefault = 0 );
 
   ~mtsController();
 
+  //! Set the real-time settings, applied in Startup
+  void SetRealTime( osaCPUMask cpumask,
+		    int priority,
+		    bool lockmemory = false,
+		    size_t prefault = 0 );
+
+  //! Apply the CPU affinity and real-time settings
+  /**
+     Called from the task thread.  Derived classes must call this
+     method first in their own Startup.  Also configures the loop
+     timing histograms for the task period.
+  */
+  void Startup();
+
 };
 
 #endif
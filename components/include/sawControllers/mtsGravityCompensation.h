@@ -4,6 +4,8 @@
 
 #include <sawControllers/mtsController.h>
 #include <sawControllers/osaGravityCompensation.h>
+#include <cisstParameterTypes/prmPositionJointGet.h>
+#include <cisstParameterTypes/prmForceTorqueJointSet.h>
 #include <sawControllers/sawControllersExport.h>
 
 class CISST_EXPORT mtsGravityCompensation : public mtsController {
@@ -19,6 +21,10 @@ class CISST_EXPORT mtsGravityCompensation : public mtsController {
   //! Write the joint torques
   mtsFunctionWrite SetTorques;
 
+  //! Joint positions and torques, sized in Startup and reused by Run
+  prmPositionJointGet    prmq;
+  prmForceTorqueJointSet prmtau;
+
  public:
 
   //! Main constructor
@@ -40,7 +46,8 @@ class CISST_EXPORT mtsGravityCompensation : public mtsController {
 
   ~mtsGravityCompensation();
 
-  void Configure( const std::string& argv );
+  //! Read the real-time settings, see mtsController::ConfigureRealTime
+  void Configure( const std::string& filename );
 
   void Startup();
   void Run();
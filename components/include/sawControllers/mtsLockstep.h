@@ -0,0 +1,117 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Deterministic stepping of periodic tasks with a virtual clock
+  \ingroup sawControllers
+*/
+
+
+#ifndef _mtsLockstep_h
+#define _mtsLockstep_h
+
+#include <vector>
+
+#include <cisstMultiTask/mtsTaskPeriodic.h>
+#include <sawControllers/mtsScriptedIO.h>
+#include <sawControllers/mtsPID.h>
+
+//! Always include last
+#include <sawControllers/sawControllersExport.h>
+
+/*!
+  Runs periodic tasks from the calling thread, in lockstep and as
+  fast as possible, using a virtual clock.  Each task runs at its
+  own period (mtsTaskPeriodic::GetPeriodicity), tasks due at the same
+  time run in the order they were added.  Before each step, scripted
+  IO components are set to the new time so they send their events
+  and return their samples for that time.
+
+  Tasks and scripted IO components must be added to the component
+  manager and connected but never created nor started, i.e. no
+  thread runs them.  Startup, Run and Cleanup are called by the
+  harness.  For each Run, the default state table is started and
+  advanced around the call, its tic and period are set to the
+  virtual time and task period (tocs and other state tables still
+  use the wall clock).  mtsPID tasks are set to use the virtual
+  clock and their events are handled from the calling thread after
+  each Run, see mtsPID::SetVirtualClock.  Loop timing statistics
+  measure the actual compute time, jitter and overruns are
+  meaningless in lockstep.
+
+  A harness is single threaded, replays can run in parallel in
+  separate processes.
+*/
+class CISST_EXPORT mtsLockstep
+{
+public:
+    mtsLockstep(void);
+    ~mtsLockstep() {}
+
+    /*! Add a task, returns false if its period isn't positive.  Must
+      be called before Startup. */
+    bool AddTask(mtsTaskPeriodic * task);
+
+    //! Add a scripted IO component, set to the new time before each step
+    void AddScript(mtsScriptedIO * script);
+
+    //! Virtual time in seconds, starts at 0
+    inline const double & Time(void) const {
+        return mTime;
+    }
+
+    //! Number of task iterations since Startup
+    inline size_t NumberOfRuns(void) const {
+        return mNumberOfRuns;
+    }
+
+    //! Reset the clock and call Startup for all scripts and tasks
+    void Startup(void);
+
+    //! Advance to the next time a task is due and run all due tasks
+    void Step(void);
+
+    //! Step until the virtual time reaches the given time
+    void RunUntil(const double time);
+
+    //! Call Cleanup for all tasks
+    void Cleanup(void);
+
+protected:
+    class Entry {
+    public:
+        mtsTaskPeriodic * Task;
+        //! Same task if it is a mtsPID, 0 otherwise
+        mtsPID * PID;
+        double Period;
+        //! Number of runs, next run is at (Count * Period)
+        size_t Count;
+        inline double Next(void) const {
+            return Count * Period;
+        }
+    };
+
+    std::vector<Entry> mEntries;
+    std::vector<mtsScriptedIO *> mScripts;
+    double mTime;
+    size_t mNumberOfRuns;
+};
+
+#endif // _mtsLockstep_h
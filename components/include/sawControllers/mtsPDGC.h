@@ -4,6 +4,8 @@
 
 #include <sawControllers/mtsController.h>
 #include <sawControllers/osaPDGC.h>
+#include <cisstParameterTypes/prmPositionJointGet.h>
+#include <cisstParameterTypes/prmForceTorqueJointSet.h>
 #include <sawControllers/sawControllersExport.h>
 
 class CISST_EXPORT mtsPDGC : public mtsController {
@@ -22,6 +24,12 @@ class CISST_EXPORT mtsPDGC : public mtsController {
   //! Write the joint torques
   mtsFunctionWrite SetTorques;
 
+  //! Desired/current positions and torques, sized in Startup and
+  //! reused by Run
+  prmPositionJointGet    prmqs;
+  prmPositionJointGet    prmq;
+  prmForceTorqueJointSet prmtau;
+
  public:
 
   //! Main constructor
@@ -48,7 +56,8 @@ class CISST_EXPORT mtsPDGC : public mtsController {
 
   ~mtsPDGC();
 
-  void Configure( const std::string& argv );
+  //! Read the real-time settings, see mtsController::ConfigureRealTime
+  void Configure( const std::string& filename );
 
   void Startup();
   void Run();
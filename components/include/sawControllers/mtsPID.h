@@ -21,14 +21,14 @@ http://www.cisst.org/cisst/license.txt.
   \file
   \brief Basic PID controller
   \ingroup sawControllers
-
-  \todo Add dError filtering
 */
 
 
 #ifndef _mtsPID_h
 #define _mtsPID_h
 
+#include <cisstOSAbstraction/osaMutex.h>
+#include <cisstVector/vctDynamicMatrixTypes.h>
 #include <cisstMultiTask/mtsTaskPeriodic.h>
 #include <cisstParameterTypes/prmForceTorqueJointSet.h>
 #include <cisstParameterTypes/prmPositionJointGet.h>
@@ -39,6 +39,18 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstParameterTypes/prmActuatorJointCoupling.h>
 
 #include <sawControllers/sawControllersRevision.h>
+#include <sawControllers/osaPIDKernel.h>
+#include <sawControllers/osaLoopTiming.h>
+#include <sawControllers/osaVelocityEstimator.h>
+#include <sawControllers/osaDerivativeFilter.h>
+#include <sawControllers/osaSetpointInterpolator.h>
+#include <sawControllers/osaTrajectoryGenerator.h>
+#include <sawControllers/osaGainSchedule.h>
+#include <sawControllers/osaPIDConfiguration.h>
+#include <sawControllers/osaTelemetryRecorder.h>
+#include <sawControllers/osaEventChannel.h>
+#include <sawControllers/osaSimulatedPlant.h>
+#include <sawControllers/mtsStateTableFootprint.h>
 
 //! Always include last
 #include <sawControllers/sawControllersExport.h>
@@ -47,6 +59,41 @@ class CISST_EXPORT mtsPID: public mtsTaskPeriodic
 {
     CMN_DECLARE_SERVICES(CMN_DYNAMIC_CREATION_ONEARG, CMN_LOG_ALLOW_DEFAULT);
 
+public:
+    /*! Rows of the gains and limits bundle used by the SetGains and
+      GetGains commands, one column per joint. */
+    typedef enum {
+        GAINS_KP = 0,
+        GAINS_KD,
+        GAINS_KI,
+        GAINS_IERROR_LIMIT_MIN,
+        GAINS_IERROR_LIMIT_MAX,
+        GAINS_POSITION_LOWER_LIMIT,
+        GAINS_POSITION_UPPER_LIMIT,
+        GAINS_EFFORT_LOWER_LIMIT,
+        GAINS_EFFORT_UPPER_LIMIT,
+        GAINS_TRACKING_ERROR_TOLERANCE,
+        GAINS_DEADBAND,
+        GAINS_IERROR_FORGET_FACTOR,
+        GAINS_NONLINEAR,
+        GAINS_OFFSET,
+        GAINS_VELOCITY_FEEDFORWARD,
+        GAINS_ACCELERATION_FEEDFORWARD,
+        NUMBER_OF_GAINS_ROWS
+    } GainsRowType;
+
+    /*! Interface for a model based feed-forward, e.g. inverse
+      dynamics.  Evaluate is called from the control loop every tick
+      with the commanded state and must not allocate memory. */
+    class FeedForwardModel {
+    public:
+        virtual ~FeedForwardModel() {}
+        virtual void Evaluate(const vctDoubleVec & position,
+                              const vctDoubleVec & velocity,
+                              const vctDoubleVec & acceleration,
+                              vctDoubleVec & effort) = 0;
+    };
+
 protected:
     // Required interface
     struct InterfaceRobotTorque {
@@ -104,15 +151,18 @@ protected:
     prmJointTypeVec mJointType;
     //! prm type feedback positoin
     prmPositionJointGet mPositionMeasure;
-    prmPositionJointGet mPositionMeasurePrevious;
     //! prm type feedback velocity
     prmVelocityJointGet mVelocityMeasure;
-    //! prm type joint state
+    //! Used if the IO component doesn't provide velocities
+    osaVelocityEstimator mVelocityEstimator;
+    /*! prm type joint state.  The joint names are not set so they
+      don't get copied in every state table slot, see mJointNames and
+      GetStateJoint. */
     prmStateJoint mStateJointMeasure, mStateJointCommand;
-
-    //! Error
-    vctDoubleVec mError;
-    vctDoubleVec mIError;
+    mtsStateTable::AccessorBase * mStateJointMeasureAccessor;
+    mtsStateTable::AccessorBase * mStateJointCommandAccessor;
+    //! Joint names from configuration file
+    std::vector<std::string> mJointNames;
 
     //! Min/max iError
     vctDoubleVec mIErrorLimitMin;
@@ -126,6 +176,58 @@ protected:
     //! Deadband (errors less than this are set to 0)
     vctDoubleVec mDeadBand;
 
+    //! Per joint feed-forward gains for commanded velocity and acceleration
+    vctDoubleVec mVelocityFeedForward;
+    vctDoubleVec mAccelerationFeedForward;
+    /*! Commanded acceleration, computed from successive commanded
+      velocities, see SetDesiredState. */
+    vctDoubleVec mCommandAcceleration;
+    double mCommandVelocityTime;
+    //! Feed-forward effort from SetDesiredState
+    vctDoubleVec mFeedForwardEffort;
+    //! Feed-forward effort from model, see SetFeedForwardModel
+    vctDoubleVec mModelEffort;
+
+    //! Filter for the derivative term, see Configure
+    osaDerivativeFilter mDerivativeFilter;
+    vctDoubleVec mDerivativeVelocity;
+
+    FeedForwardModel * mFeedForwardModel;
+
+    //! External clock, see SetVirtualClock
+    const double * mVirtualTime;
+
+    //! Time used by the controller, state table tic unless a virtual clock is set
+    inline double Now(void) const {
+        return mVirtualTime ? *mVirtualTime : StateTable.GetTic();
+    }
+
+    /*! Smooth reference between setpoints received at a lower rate
+      than the control loop, see Configure. */
+    osaSetpointInterpolator mInterpolator;
+
+    //! Trajectory towards goals from SetGoalPosition
+    osaTrajectoryGenerator mTrajectoryGenerator;
+    vctDoubleVec mTrajectoryGoal;
+
+    //! Gains looked up per joint, overrides mGains for scheduled joints
+    osaGainSchedule mGainSchedule;
+    //! User provided scheduling variable, see SetGainScheduleVariable
+    vctDoubleVec mGainScheduleVariable;
+    //! LoadGainSchedule is not queued, one writer at a time
+    osaMutex mGainScheduleMutex;
+
+    //! Current gains and limits, see GainsRowType
+    vctDoubleMat mGainsBundle;
+    //! Bundles from SetGains, applied at the top of Run
+    osaTripleBuffer<vctDoubleMat> mGainsUpdate;
+    //! SetGains is not queued, one writer at a time
+    osaMutex mGainsMutex;
+    //! Position limits defined in the configuration file, see ReloadConfiguration
+    bool mHasPositionLimits;
+    //! Latest bundle applied, read by ReloadConfiguration
+    mtsStateTable::AccessorBase * mGainsBundleAccessor;
+
     //! Enable mtsPID controller
     bool mEnabled;
 
@@ -137,18 +239,92 @@ protected:
 
     bool mTrackingErrorEnabled;
     vctDoubleVec mTrackingErrorTolerances;
-    vctBoolVec mPreviousTrackingErrorFlag, mTrackingErrorFlag;
+    vctBoolVec mTrackingErrorFlag;
+    //! Position errors when the tracking error was detected
+    vctDoubleVec mTrackingErrorSnapshot;
+
+    /*! PID kernel, holds a copy of gains and limits along with
+      errors and integral errors.  See UpdateKernelConfiguration.  By
+      default this points to mKernelLocal but a range of joints in a
+      kernel evaluated for several arms at once can be used instead,
+      see UseKernel. */
+    osaPIDKernel * mKernel;
+    osaPIDKernel mKernelLocal;
+    //! Index of first joint in mKernel
+    size_t mKernelFirst;
+
+    //! View on a kernel field for the joints of this component
+    inline vctDynamicVectorRef<double> KernelField(const osaPIDKernel::FieldType field) {
+        return mKernel->Field(field, mKernelFirst, mNumberOfActiveJoints);
+    }
+
+    //! Compute/IO/jitter histograms, see GetLoopTiming
+    osaLoopTiming mLoopTiming;
+
+    /*! Full rate recorder, one record per tick with the time and,
+      for each joint, measured position, velocity and effort,
+      commanded position and effort, error and integral of error. */
+    osaTelemetryRecorder mTelemetry;
+    enum {TELEMETRY_FIELDS_PER_JOINT = 7};
+    //! StartTelemetry and StopTelemetry are not queued, one caller at a time
+    osaMutex mTelemetryMutex;
+
+    /*! Codes for events reported through mEvents, the payload is a
+      mask and snapshot of vectors, see ReportEvent. */
+    typedef enum {
+        EVENT_TRACKING_ERROR = 0,
+        EVENT_POSITION_LIMIT,
+        EVENT_GOAL_NOT_ENABLED,
+        EVENT_GOAL_NO_TRAJECTORY_LIMITS,
+        EVENT_SIMULATION_CLAMPED,
+        NUMBER_OF_EVENTS
+    } EventType;
+    enum {EVENT_VECTORS = 5};
+
+    /*! Errors and warnings from the control loop are formatted, logged
+      and sent by the channel's thread. */
+    osaEventChannel mEvents;
+
+    class EventHandler: public osaEventChannel::Handler {
+    public:
+        EventHandler(mtsPID * pid): mPID(pid) {}
+        void HandleEvent(const size_t code, const double time,
+                         const double * payload, const size_t suppressed) {
+            mPID->HandleEvent(code, time, payload, suppressed);
+        }
+    protected:
+        mtsPID * mPID;
+    } mEventHandler;
+
+    /*! Messages are sent from the control loop, the channel's thread
+      and callers of non queued commands, one sender at a time, see
+      SendError. */
+    osaMutex mMessagesMutex;
 
     // Flag to determine if this is connected to actual IO/hardware or
     // simulated
     bool mIsSimulated;
 
+    //! Simulated dynamics instead of copying commands, see SetSimulatedPlant
+    bool mUseSimulatedPlant;
+    osaSimulatedPlant mSimulatedPlant;
+    //! Time of the last plant update, negative before the first one
+    double mSimulatedPlantTime;
+
     // Counter of active joints
     size_t mNumberOfActiveJoints;
 
-    //! Configuration state table
+    //! Directory for compiled configuration files, see SetConfigurationCache
+    std::string mConfigurationCache;
+
+    /*! Configuration state table.  The history depth of this table
+      and the main StateTable can be set in the configuration file,
+      see Configure. */
     mtsStateTable mConfigurationStateTable;
 
+    //! Size of data added to the state tables, see MemoryFootprint
+    mtsStateTableFootprint mFootprint;
+
     struct {
         //! Enable event
         mtsFunctionWrite Enabled;
@@ -158,6 +334,10 @@ protected:
         mtsFunctionWrite EnabledJoints;
         //! Coupling changed event
         mtsFunctionWrite Coupling;
+        //! Loop timing summary, once per second
+        mtsFunctionWrite LoopTiming;
+        //! Goal reached (true) or abandoned (false)
+        mtsFunctionWrite GoalReached;
     } Events;
 
     mtsInterfaceProvided * mInterface;
@@ -176,10 +356,73 @@ protected:
       in position or effort mode. */
     void SetDesiredEffort(const prmForceTorqueJointSet & command);
 
+    /*! Desired position with optional velocity and effort (vectors
+      can be empty).  The velocity is used for the derivative term and
+      the velocity feed-forward, the acceleration feed-forward uses the
+      difference between successive velocities and the effort is added
+      to the PID output. */
+    void SetDesiredState(const prmStateJoint & command);
+
+    /*! Move to goal using jerk limited trajectories computed on the
+      controller, see osaTrajectoryGenerator.  The trajectory starts
+      from the current commanded state, even if moving, and is
+      abandoned if a setpoint is received (SetDesiredPosition or
+      SetDesiredState) or the controller is disabled. */
+    void SetGoalPosition(const prmPositionJointSet & command);
+
+    //! Abandon current trajectory, if any
+    void StopTrajectory(void);
+
+    //! Clamp commanded positions, see mCheckPositionLimit
+    void ApplyPositionLimits(void);
+
     void Init(void);
 
     void SetupInterfaces(void);
 
+    /*! Copy gains and limits to the PID kernel, needs to be called
+      after any configuration change. */
+    void UpdateKernelConfiguration(void);
+
+    /*! Set all gains and limits at once, see GainsRowType.  Not
+      queued, the bundle is validated in the caller's thread and
+      applied on a single tick at the top of Run so the controller
+      never uses a partial update. */
+    void SetGains(const vctDoubleMat & gains);
+
+    //! Validate and publish a bundle, see SetGains
+    bool PublishGains(const vctDoubleMat & gains);
+
+    //! Apply last bundle from SetGains, control loop only
+    void ApplyGains(void);
+
+    /*! Size all data members and use values from a parsed
+      configuration, see Configure. */
+    bool ApplyConfiguration(const osaPIDConfiguration & configuration);
+
+    /*! Reload gains and limits from a configuration file, same format
+      as Configure.  Not queued, the file is parsed in the caller's
+      thread.  The number of joints and joint types must be the same
+      as the current configuration.  Gains, position limits, integral
+      limits and forget factors, deadbands, non linear coefficients,
+      tracking error tolerances, offsets and velocity/acceleration
+      feed-forward gains are published as one bundle (see SetGains)
+      and applied on a single tick.  The file is rejected if it
+      defines position limits (<pos>) and the current configuration
+      doesn't, or the other way around.  Other parameters (filters,
+      trajectory limits, interpolation...) require Configure, gain
+      schedule tables can be reloaded with LoadGainSchedule. */
+    void ReloadConfiguration(const std::string & filename);
+
+    /*! Load gain schedule tables from a configuration file, same
+      format as Configure.  Not queued, the file is parsed in the
+      caller's thread and the tables are picked up by the control
+      loop at the next tick. */
+    void LoadGainSchedule(const std::string & filename);
+
+    //! Scheduling variable for joints using Variable="User"
+    void SetGainScheduleVariable(const vctDoubleVec & variable);
+
     void Enable(const bool & enable);
 
     void EnableJoints(const vctBoolVec & enable);
@@ -194,9 +437,10 @@ protected:
       the simulated flag and sets position/effort based on user
       commands if it is simulated.  If the IO component doesn't
       provide the velocity, the method estimates the velocity based on
-      the previous measured position.  When changing coupling, the
-      previous position might be irrelevant so the user can skip
-      velocity computation.  In this case, velocity is set to 0. */
+      the previous measured positions, see osaVelocityEstimator.  When
+      changing coupling, the previous positions might be irrelevant so
+      the user can skip velocity computation.  In this case, velocity
+      is set to 0 and the estimator history is cleared. */
     void GetIOData(const bool computeVelocity);
 
     /*! Utility method to convert vector of doubles
@@ -209,6 +453,40 @@ protected:
 
     void ErrorEventHandler(const mtsMessage & message);
 
+    //! Latest joint state from the state table with joint names
+    void GetStateJoint(prmStateJoint & state) const;
+    void GetStateJointDesired(prmStateJoint & state) const;
+
+    //! Size the telemetry ring buffer for a given duration
+    void ConfigureTelemetry(const double bufferDuration);
+
+    /*! Start recording to a binary file, see osaTelemetryRecorder for
+      the format. */
+    void StartTelemetry(const std::string & filename);
+
+    void StopTelemetry(void);
+
+    //! Fill a telemetry record, called at the end of Run
+    void RecordTelemetry(double * record);
+
+    /*! Report an event with a mask and up to 4 vectors (null
+      pointers are sent as zeros), doesn't allocate.  Control loop
+      only. */
+    void ReportEvent(const EventType event, const vctBoolVec & mask,
+                     const vctDoubleVec * vector1 = 0,
+                     const vctDoubleVec * vector2 = 0,
+                     const vctDoubleVec * vector3 = 0,
+                     const vctDoubleVec * vector4 = 0);
+
+    //! Format, log and send an event, channel thread only
+    void HandleEvent(const size_t code, const double time,
+                     const double * payload, const size_t suppressed);
+
+    //! Send a message on the provided interface, from any thread
+    void SendError(const std::string & message);
+    void SendWarning(const std::string & message);
+    void SendStatus(const std::string & message);
+
 public:
 
     /**
@@ -225,15 +503,109 @@ public:
     /**
      * @brief Configure PID gains & params
      *
+     * The history depth of the state tables can be set with
+     * <statetable Size="256" ConfigurationSize="10"/> under
+     * <controller>.  If the IO component doesn't provide velocities,
+     * each joint can select a velocity filter with <velocity
+     * Filter="FiniteDifference|LowPass|SavitzkyGolay|AdaptiveWindow"
+     * Cutoff="Hz" Window="samples" Order="2" NoiseLevel="rad or m"/>,
+     * see osaVelocityEstimator.  The derivative term can be filtered
+     * with <derivative Filter="None|Butterworth|Tustin|Observer"
+     * Cutoff="Hz" ProcessNoise="" MeasurementNoise=""/>, see
+     * osaDerivativeFilter.  Feed-forward gains for the commanded
+     * velocity and acceleration (see SetStateJoint) are set with
+     * <pid VelocityFeedForward="" AccelerationFeedForward=""/>.
+     * Setpoints can be interpolated at the control rate with
+     * <interpolation Type="None|Linear|CubicHermite|Quintic"
+     * MaxInterval="seconds"/>, see osaSetpointInterpolator.
+     * Limits for goals are set per joint with <trajectory
+     * MaxVelocity="" MaxAcceleration="" MaxJerk=""/>, in SI units.
+     * Gains can be scheduled per joint with <schedule
+     * Variable="Position|User"> and a list of <point Value=""
+     * PGain="" IGain="" DGain=""/> sorted by value, see
+     * osaGainSchedule and LoadGainSchedule.
+     * Joints used with SetSimulatedPlant are defined with <plant
+     * Mass="" Damping="" Friction="" Backlash=""/> (default unit mass)
+     * and the integration step with <simulation SubStep="seconds"/>
+     * under <controller>, see osaSimulatedPlant.
+     *
+     * If a cache directory is set (see SetConfigurationCache), the
+     * parsed configuration is saved in a compiled file and later
+     * calls use it as long as the XML file is unchanged.
+     *
      * @param filename  The name of the configuration file
      */
     void Configure(const std::string& filename);
+
+    /*! Directory used to store compiled configuration files, must be
+      called before Configure.  Compiled files are named after the XML
+      file and the hash of its content (<name>.<hash>.compiled), see
+      osaPIDConfiguration.  Empty (default) to always parse XML. */
+    inline void SetConfigurationCache(const std::string & directory) {
+        mConfigurationCache = directory;
+    }
     void Startup(void);
     void Run(void);
     void Cleanup(void);
 
     void SetSimulated(void);
 
+    /*! Simulated mode with a plant driven by the computed efforts
+      instead of copying the commanded positions.  The plant is
+      integrated every time the component reads its inputs.  An
+      optional model replaces the per joint masses (e.g. forward
+      dynamics of a robManipulator), the component doesn't own it.
+      The plant starts at rest from the commanded position, i.e. the
+      last position sent with SetPositionJoint before the first
+      read.  This must be called before the component starts. */
+    void SetSimulatedPlant(osaSimulatedPlant::Model * model = 0);
+
+    inline size_t NumberOfActiveJoints(void) const {
+        return mNumberOfActiveJoints;
+    }
+
+    /*! Use an external clock instead of the state table tic for
+      setpoints, trajectories, timestamps and events, e.g.
+      mtsLockstep::Time.  0 (default) to use the state table.  With
+      an external clock, events are not handled by a thread, the
+      harness calls DrainEvents after each Run.  Must be called
+      before Startup. */
+    inline void SetVirtualClock(const double * time) {
+        mVirtualTime = time;
+    }
+
+    //! Format and send events reported so far, only with a virtual clock
+    inline void DrainEvents(void) {
+        mEvents.DrainNow();
+    }
+
+    /*! Set the feed-forward model, 0 to remove it.  The component
+      doesn't own the model.  This must be called after Configure and
+      before the component starts. */
+    void SetFeedForwardModel(FeedForwardModel * model);
+
+    //! Bytes used by the history of the data added to state tables
+    inline size_t MemoryFootprint(void) const {
+        return mFootprint.Bytes();
+    }
+
+    /*! Use a range of joints in an external kernel instead of this
+      component's own kernel.  Current kernel data, including errors,
+      is copied.  This must be called after Configure and before the
+      component starts.  Run then does nothing, the owner of the
+      kernel starts the default state table, calls RunBeforeKernel,
+      evaluates the kernel, calls RunAfterKernel and advances the
+      state table, see mtsPIDMulti. */
+    void UseKernel(osaPIDKernel & kernel, const size_t first);
+
+    /*! First part of Run: process commands, read IO, copy inputs and
+      modes to the kernel. */
+    void RunBeforeKernel(void);
+
+    /*! Last part of Run, once the kernel has been evaluated: report
+      tracking errors, write efforts and record telemetry. */
+    void RunAfterKernel(void);
+
 protected:
     /**
      * @brief Set controller P gains
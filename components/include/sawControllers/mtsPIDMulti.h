@@ -0,0 +1,108 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Multiple PID controllers in a single thread
+  \ingroup sawControllers
+*/
+
+
+#ifndef _mtsPIDMulti_h
+#define _mtsPIDMulti_h
+
+#include <cisstMultiTask/mtsTaskPeriodic.h>
+#include <sawControllers/mtsPID.h>
+
+//! Always include last
+#include <sawControllers/sawControllersExport.h>
+
+/*!
+  Periodic task running multiple mtsPID controllers, one per arm, in
+  its own thread.  Each arm is an mtsPID component with the same
+  provided "Controller" and required "RobotJointTorqueInterface"
+  interfaces so clients don't need to change.  The arms are executed
+  by this task, i.e. they don't have their own thread (ExecIn/ExecOut
+  is used so the component manager doesn't create threads for them).
+  All arms share a single osaPIDKernel, each arm using a contiguous
+  range of joints.  On each tick, all arms process their commands and
+  read their IO, the kernel is evaluated once for all joints, then all
+  arms report errors and write their efforts.
+
+  The configuration file lists the PID configuration file for each arm:
+  \code
+  <controllers>
+    <controller name="PSM1-PID" file="sawControllersPID-PSM1.xml"/>
+    <controller name="PSM2-PID" file="sawControllersPID-PSM2.xml"/>
+  </controllers>
+  \endcode
+  Relative file names are resolved using the directory of the
+  configuration file first.
+
+  Once this component has been added to the component manager,
+  ConnectArms must be called before creating components.  Arms are
+  owned by the component manager, like any other component.
+*/
+class CISST_EXPORT mtsPIDMulti: public mtsTaskPeriodic
+{
+    CMN_DECLARE_SERVICES(CMN_DYNAMIC_CREATION_ONEARG, CMN_LOG_ALLOW_DEFAULT);
+
+public:
+    mtsPIDMulti(const std::string & componentName, const double periodInSeconds);
+    mtsPIDMulti(const mtsTaskPeriodicConstructorArg & arg);
+    ~mtsPIDMulti();
+
+    void Configure(const std::string & filename);
+    void Startup(void);
+    void Run(void);
+    void Cleanup(void);
+
+    /*! Create and configure an mtsPID for a single arm.  The new
+      component is added to the component manager.  Returns 0 if the
+      arm has no active joint or can't be added. */
+    mtsPID * AddArm(const std::string & name, const std::string & filename);
+
+    /*! Connect the ExecIn interface of each arm to the ExecOut
+      interface of this component.  Must be called after this
+      component has been added to the component manager. */
+    bool ConnectArms(void);
+
+    inline size_t NumberOfArms(void) const {
+        return mArms.size();
+    }
+
+protected:
+    void Init(void);
+
+    //! Resize the shared kernel and assign a range of joints to each arm
+    void UpdateKernel(void);
+
+    typedef std::vector<mtsPID *> ArmsType;
+    ArmsType mArms;
+
+    //! Kernel shared by all arms, evaluated once per tick
+    osaPIDKernel mKernel;
+
+    //! Set by ConnectArms, arms can't be added after
+    bool mArmsConnected;
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(mtsPIDMulti);
+
+#endif // _mtsPIDMulti_h
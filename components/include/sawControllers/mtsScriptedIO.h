@@ -0,0 +1,178 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief IO stand-in replaying recorded data, see mtsLockstep
+  \ingroup sawControllers
+*/
+
+
+#ifndef _mtsScriptedIO_h
+#define _mtsScriptedIO_h
+
+#include <string>
+#include <vector>
+
+#include <cisstMultiTask/mtsComponent.h>
+#include <cisstMultiTask/mtsFunctionWrite.h>
+#include <cisstParameterTypes/prmJointType.h>
+#include <cisstParameterTypes/prmPositionJointGet.h>
+#include <cisstParameterTypes/prmForceTorqueJointSet.h>
+#include <cisstParameterTypes/prmActuatorJointCoupling.h>
+#include <cisstParameterTypes/prmPositionCartesianGet.h>
+#include <cisstParameterTypes/prmPositionCartesianSet.h>
+#include <cisstParameterTypes/prmEventButton.h>
+
+//! Always include last
+#include <sawControllers/sawControllersExport.h>
+
+/*!
+  Component without thread providing interfaces compatible with the
+  IO used by mtsPID and mtsTeleOperation.  Data is replayed from text
+  files, one sample per line starting with the time in seconds, lines
+  starting with # are ignored.  Samples are held until the next one
+  (zero order hold), the first sample is used before its time.
+
+  The current time is set with SetTime, usually by mtsLockstep.
+  Commands sent by the controllers are kept so they can be read back
+  by a test or recorded.
+*/
+class CISST_EXPORT mtsScriptedIO: public mtsComponent
+{
+    CMN_DECLARE_SERVICES(CMN_NO_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
+
+public:
+    mtsScriptedIO(const std::string & componentName);
+    ~mtsScriptedIO();
+
+    /*! Joint positions, each line has the time and one position per
+      joint.  Compatible with mtsPID's RobotJointTorqueInterface.
+      Efforts sent with SetTorqueJoint are returned as measured
+      efforts. */
+    bool AddJointInterface(const std::string & interfaceName,
+                           const std::string & filename,
+                           const prmJointTypeVec & jointType);
+
+    /*! Cartesian positions, each line has the time, the translation
+      (3 values), the rotation matrix (9 values, row major) and
+      optionally the gripper position.  Compatible with
+      mtsTeleOperation's Master and Slave.  The last goal and control
+      state sent are returned by GetPositionCartesianDesired and
+      GetRobotControlState. */
+    bool AddCartesianInterface(const std::string & interfaceName,
+                               const std::string & filename);
+
+    /*! Button events, each line has the time and 1 (pressed) or 0
+      (released).  Events are sent once their time is reached.  The
+      interface provides the event Button, compatible with
+      mtsTeleOperation's Clutch and OperatorPresent. */
+    bool AddButtonInterface(const std::string & interfaceName,
+                            const std::string & filename);
+
+    /*! Select samples for the time and send button events up to the
+      time.  Going back in time restarts all scripts. */
+    void SetTime(const double time);
+
+    inline double Time(void) const {
+        return mTime;
+    }
+
+protected:
+    //! Samples loaded from a text file
+    class Track {
+    public:
+        Track(void): NumberOfValues(0), Index(0) {}
+
+        /*! Each line must have the time and between minimumValues and
+          NumberOfValues values, missing values are set to 0.  If
+          NumberOfValues is 0, it is set from the first line. */
+        bool Load(const std::string & filename, const size_t minimumValues);
+
+        //! Index of the sample to use at a given time
+        void Seek(const double time);
+
+        inline const double * Sample(void) const {
+            return &(Values[Index * NumberOfValues]);
+        }
+
+        std::vector<double> Times;
+        std::vector<double> Values;
+        size_t NumberOfValues;
+        size_t Index;
+    };
+
+    class JointInterface {
+    public:
+        void Update(const double time);
+        void GetPositionJoint(prmPositionJointGet & position) const;
+        void GetTorqueJoint(vctDoubleVec & effort) const;
+        void GetJointType(prmJointTypeVec & jointType) const;
+        void SetTorqueJoint(const prmForceTorqueJointSet & effort);
+        void SetCoupling(const prmActuatorJointCoupling & coupling);
+
+        Track Samples;
+        prmJointTypeVec JointType;
+        prmPositionJointGet Position;
+        vctDoubleVec Effort;
+        mtsFunctionWrite Coupling;
+        mtsFunctionWrite Error;
+    };
+
+    class CartesianInterface {
+    public:
+        void Update(const double time);
+        void GetPositionCartesian(prmPositionCartesianGet & position) const;
+        void GetGripperPosition(double & position) const;
+        void SetPositionCartesian(const prmPositionCartesianSet & position);
+        void SetJawPosition(const double & position);
+        void SetRobotControlState(const std::string & state);
+        void GetPositionCartesianDesired(prmPositionCartesianSet & position) const;
+        void GetRobotControlState(std::string & state) const;
+
+        Track Samples;
+        prmPositionCartesianGet Position;
+        double GripperPosition;
+        prmPositionCartesianSet PositionDesired;
+        double JawPosition;
+        std::string ControlState;
+        mtsFunctionWrite Error;
+        mtsFunctionWrite ManipClutch;
+    };
+
+    class ButtonInterface {
+    public:
+        //! Send all events after the previous time up to the time
+        void Update(const double time);
+
+        Track Samples;
+        //! Number of events sent
+        size_t Sent;
+        mtsFunctionWrite Button;
+    };
+
+    std::vector<JointInterface *> mJoints;
+    std::vector<CartesianInterface *> mCartesians;
+    std::vector<ButtonInterface *> mButtons;
+    double mTime;
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(mtsScriptedIO);
+
+#endif // _mtsScriptedIO_h
@@ -0,0 +1,103 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Memory footprint of the data added to state tables
+  \ingroup sawControllers
+*/
+
+
+#ifndef _mtsStateTableFootprint_h
+#define _mtsStateTableFootprint_h
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <cisstVector/vctDynamicMatrix.h>
+#include <cisstMultiTask/mtsStateTable.h>
+#include <cisstParameterTypes/prmForceTorqueJointSet.h>
+#include <cisstParameterTypes/prmPositionJointGet.h>
+#include <cisstParameterTypes/prmVelocityJointGet.h>
+#include <cisstParameterTypes/prmStateJoint.h>
+
+//! Always include last
+#include <sawControllers/sawControllersExport.h>
+
+/*!
+  Keeps track of the size of the data added to state tables by a
+  component so one can report how much memory the history uses.
+  Data has to be added through AddData instead of
+  mtsStateTable::AddData.  Sizes are estimated when the data is
+  added, vectors should already have their final size.  Data added
+  by mtsTask itself (Tic, Toc, period statistics...) is not counted.
+*/
+class CISST_EXPORT mtsStateTableFootprint
+{
+public:
+    template <class _elementType>
+    void AddData(mtsStateTable & table, _elementType & element, const std::string & name) {
+        table.AddData(element, name);
+        Entry(table).BytesPerSample += DataSize(element);
+    }
+
+    //! Bytes used by all slots of a table, 0 if table is not known
+    size_t Bytes(const mtsStateTable & table) const;
+
+    //! Bytes used by all slots of all tables
+    size_t Bytes(void) const;
+
+    //! One line per table with depth, bytes per sample and total
+    void ToStream(std::ostream & outputStream) const;
+
+    // estimated size of one sample
+    template <class _elementType>
+    static inline size_t DataSize(const _elementType &) {
+        return sizeof(_elementType);
+    }
+
+    template <class _elementType>
+    static inline size_t DataSize(const vctDynamicVector<_elementType> & vector) {
+        return sizeof(vector) + vector.size() * sizeof(_elementType);
+    }
+
+    template <class _elementType>
+    static inline size_t DataSize(const vctDynamicMatrix<_elementType> & matrix) {
+        return sizeof(matrix) + matrix.size() * sizeof(_elementType);
+    }
+
+    static size_t DataSize(const std::vector<std::string> & strings);
+    static size_t DataSize(const prmPositionJointGet & data);
+    static size_t DataSize(const prmVelocityJointGet & data);
+    static size_t DataSize(const prmForceTorqueJointSet & data);
+    static size_t DataSize(const prmStateJoint & data);
+
+protected:
+    struct TableEntry {
+        const mtsStateTable * Table;
+        size_t BytesPerSample;
+    };
+
+    TableEntry & Entry(const mtsStateTable & table);
+
+    std::vector<TableEntry> mTables;
+};
+
+#endif // _mtsStateTableFootprint_h
@@ -24,6 +24,8 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstParameterTypes/prmPositionCartesianGet.h>
 #include <cisstParameterTypes/prmPositionCartesianSet.h>
 #include <cisstRobot/robManipulator.h>
+#include <sawControllers/osaLoopTiming.h>
+#include <sawControllers/mtsStateTableFootprint.h>
 
 //! Always include last
 #include <sawControllers/sawControllersExport.h>
@@ -47,6 +49,9 @@ public:
     mtsTeleOperation(const mtsTaskPeriodicConstructorArg & arg);
     ~mtsTeleOperation(){}
 
+    /*! The configuration file is optional, it can be used to set
+      the history depth of the state tables with <statetable
+      Size="256" ConfigurationSize="10"/> under <teleoperation>. */
     void Configure(const std::string & filename = "");
     void Startup(void);
     void Run(void);
@@ -60,6 +65,11 @@ public:
     void LockRotation(const bool & lock);
     void LockTranslation(const bool & lock);
 
+    //! Bytes used by the history of the data added to state tables
+    inline size_t MemoryFootprint(void) const {
+        return Footprint.Bytes();
+    }
+
 private:
 
     void Init(void);
@@ -89,6 +99,9 @@ private:
         mtsFunctionWrite TranslationLocked;
     } ConfigurationEvents;
 
+    //! Loop timing summary, once per second
+    mtsFunctionWrite LoopTimingEvent;
+
     void Enable(const bool & enable);
 
     /**
@@ -149,6 +162,11 @@ private:
     vctMatRot3 MasterClutchedOrientation;
 
     mtsStateTable * ConfigurationStateTable;
+    //! Size of data added to the state tables, see MemoryFootprint
+    mtsStateTableFootprint Footprint;
+
+    //! Compute/IO/jitter histograms, see GetLoopTiming
+    osaLoopTiming LoopTiming;
 };
 
 CMN_DECLARE_SERVICES_INSTANTIATION(mtsTeleOperation);
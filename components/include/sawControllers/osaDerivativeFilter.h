@@ -0,0 +1,116 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Per joint filters for the derivative term of a PID
+  \ingroup sawControllers
+*/
+
+
+#ifndef _osaDerivativeFilter_h
+#define _osaDerivativeFilter_h
+
+#include <cisstVector/vctDynamicVector.h>
+#include <cisstVector/vctDynamicVectorRef.h>
+#include <cisstVector/vctDynamicConstVectorRef.h>
+
+//! Always include last
+#include <sawControllers/sawControllersExport.h>
+
+/*!
+  Filters the velocity used for the derivative term of a PID.  Each
+  joint uses one of:
+
+  - NONE: measured velocity, no filtering.
+  - BUTTERWORTH: second order Butterworth low pass filter on the
+    measured velocity, cutoff frequency in Hz.
+  - TUSTIN: derivative of the measured position with a first order
+    low pass, s / (tau s + 1) with tau = 1 / (2 pi cutoff),
+    discretized with Tustin's method.
+  - OBSERVER: velocity from a steady state Kalman filter (alpha-beta
+    filter) on the measured position with a constant velocity model.
+    Gains are computed from the process noise (standard deviation of
+    the acceleration) and the measurement noise (standard deviation
+    of the position).
+
+  All filters reduce to a biquad on either the measured position or
+  velocity.  Coefficients are computed by the setters for a fixed
+  sampling period so Evaluate has the same cost for all filters and
+  runs one branch-free loop over all joints.  The filter state is
+  initialized on the first call to Evaluate after SetSize or Reset.
+*/
+class CISST_EXPORT osaDerivativeFilter
+{
+public:
+    typedef enum {
+        NONE = 0,
+        BUTTERWORTH,
+        TUSTIN,
+        OBSERVER
+    } FilterType;
+
+    osaDerivativeFilter(void);
+    ~osaDerivativeFilter() {}
+
+    //! Set number of joints, all joints use NONE
+    void SetSize(const size_t numberOfJoints);
+
+    inline size_t size(void) const {
+        return mFilter.size();
+    }
+
+    void SetNone(const size_t joint);
+    bool SetButterworth(const size_t joint, const double cutoffFrequency, const double period);
+    bool SetTustin(const size_t joint, const double cutoffFrequency, const double period);
+    bool SetObserver(const size_t joint, const double processNoise, const double measurementNoise,
+                     const double period);
+
+    inline FilterType Filter(const size_t joint) const {
+        return static_cast<FilterType>(mFilter[joint]);
+    }
+
+    //! Re-initialize the filter states on next Evaluate
+    inline void Reset(void) {
+        mInitialize = true;
+    }
+
+    //! Compute filtered velocities, sizes must match the number of joints
+    void Evaluate(const vctDynamicConstVectorRef<double> & position,
+                  const vctDynamicConstVectorRef<double> & velocity,
+                  vctDynamicVectorRef<double> filtered);
+
+protected:
+    void SetCoefficients(const size_t joint, const FilterType filter, const bool usePosition,
+                         const double b0, const double b1, const double b2,
+                         const double a1, const double a2);
+
+    vctDynamicVector<int> mFilter;
+    //! 1.0 if the input is the position, 0.0 for velocity
+    vctDynamicVector<double> mUsePosition;
+    // biquad coefficients, a0 is 1
+    vctDynamicVector<double> mB0, mB1, mB2, mA1, mA2;
+    //! Steady state output for a constant input
+    vctDynamicVector<double> mGain;
+    // transposed direct form II states
+    vctDynamicVector<double> mState1, mState2;
+    bool mInitialize;
+};
+
+#endif // _osaDerivativeFilter_h
@@ -0,0 +1,162 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Deferred, rate limited events from a control loop
+  \ingroup sawControllers
+*/
+
+
+#ifndef _osaEventChannel_h
+#define _osaEventChannel_h
+
+#include <vector>
+
+#include <cisstOSAbstraction/osaThread.h>
+#include <sawControllers/osaRingBuffer.h>
+
+//! Always include last
+#include <sawControllers/sawControllersExport.h>
+
+/*!
+  Moves event reporting (string formatting, logs, messages) out of
+  the control loop.  The control loop is the single producer, it
+  reserves a fixed size record for an event code, copies the data it
+  wants to report (masks, snapshot of vectors...) and commits it.  A
+  drainer thread is the single consumer, it passes each record to a
+  Handler which can format and send messages.  The producer never
+  blocks nor allocates.
+
+  Each code has a minimum interval between two events; events
+  reserved before the interval has elapsed are suppressed and the
+  number of suppressed events is passed to the handler with the next
+  event for the same code.  Records are dropped if the ring buffer is
+  full, they are also counted as suppressed.
+
+  For deterministic runs (see mtsLockstep), the channel can be
+  started without thread, the producer then calls DrainNow to handle
+  the events committed so far.
+*/
+class CISST_EXPORT osaEventChannel
+{
+public:
+    //! Called from the drainer thread (or DrainNow) for each event
+    class Handler {
+    public:
+        virtual ~Handler() {}
+        virtual void HandleEvent(const size_t code, const double time,
+                                 const double * payload,
+                                 const size_t suppressed) = 0;
+    };
+
+    osaEventChannel(void);
+    ~osaEventChannel();
+
+    /*! Allocate the ring buffer, must be called before Start.  All
+      codes start with the same minimum interval. */
+    void Configure(const size_t numberOfCodes, const size_t payloadSize,
+                   const size_t capacity, const double minimumInterval);
+
+    //! Minimum interval between two events for a given code
+    void SetMinimumInterval(const size_t code, const double interval);
+
+    /*! Start the drainer thread, or only accept events if useThread
+      is false, see DrainNow. */
+    bool Start(Handler * handler, const bool useThread = true);
+
+    //! Stop the drainer thread once all committed events are handled
+    void Stop(void);
+
+    /*! Handle all committed events from the calling thread, only if
+      started without thread. */
+    void DrainNow(void);
+
+    inline bool IsRunning(void) const {
+        return osaRingBuffer::Load(mRunning) != 0;
+    }
+
+    inline size_t PayloadSize(void) const {
+        return mPayloadSize;
+    }
+
+    /*! Payload of the next event, 0 if suppressed (rate limit),
+      dropped (ring buffer full) or not running.  Producer only. */
+    inline double * Reserve(const size_t code, const double time) {
+        if (!IsRunning()) {
+            return 0;
+        }
+        if ((mLastTime[code] >= 0.0) && ((time - mLastTime[code]) < mMinimumInterval[code])) {
+            mSuppressed[code]++;
+            return 0;
+        }
+        double * record = mRing.Reserve();
+        if (!record) {
+            mSuppressed[code]++;
+            mDropped++;
+            return 0;
+        }
+        record[0] = static_cast<double>(code);
+        record[1] = time;
+        record[2] = static_cast<double>(mSuppressed[code]);
+        mReservedCode = code;
+        mReservedTime = time;
+        return record + HEADER_SIZE;
+    }
+
+    //! Publish the event returned by Reserve.  Producer only.
+    inline void Commit(void) {
+        mLastTime[mReservedCode] = mReservedTime;
+        mSuppressed[mReservedCode] = 0;
+        mRing.Commit();
+    }
+
+    //! Number of events dropped since Start
+    inline size_t Dropped(void) const {
+        return mDropped;
+    }
+
+protected:
+    //! Code, time and number of suppressed events
+    enum {HEADER_SIZE = 3};
+
+    void * Drain(int);
+    //! Handle all committed events, drainer thread only
+    void HandleEvents(void);
+
+    size_t mPayloadSize;
+    osaRingBuffer mRing;
+
+    // producer only
+    std::vector<double> mMinimumInterval;
+    std::vector<double> mLastTime;
+    std::vector<size_t> mSuppressed;
+    size_t mReservedCode;
+    double mReservedTime;
+    size_t mDropped;
+
+    osaRingBuffer::IndexType mRunning;
+    osaRingBuffer::IndexType mStopRequested;
+    bool mUseThread;
+
+    Handler * mHandler;
+    osaThread mThread;
+};
+
+#endif // _osaEventChannel_h
@@ -0,0 +1,133 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Per joint PID gain scheduling tables
+  \ingroup sawControllers
+*/
+
+
+#ifndef _osaGainSchedule_h
+#define _osaGainSchedule_h
+
+#include <vector>
+
+#include <cisstVector/vctDynamicVectorRef.h>
+#include <cisstVector/vctDynamicConstVectorRef.h>
+#include <sawControllers/osaTripleBuffer.h>
+
+//! Always include last
+#include <sawControllers/sawControllersExport.h>
+
+/*!
+  PID gains looked up per joint in a table indexed by a scheduling
+  variable, either the measured position of the joint or a variable
+  provided by the user (e.g. payload).  Gains are linearly
+  interpolated between points and constant outside the table.  Joints
+  without a table keep their fixed gains.
+
+  Tables are built by the caller (any thread) and published with
+  SetTable.  The control loop picks up the latest table with Update
+  and then calls Evaluate, neither allocates nor blocks, see
+  osaTripleBuffer.  Evaluate uses a binary search so its cost grows
+  with the log of the number of points.
+*/
+class CISST_EXPORT osaGainSchedule
+{
+public:
+    typedef enum {
+        NONE = 0,
+        POSITION,
+        USER
+    } VariableType;
+
+    //! Tables for all joints, one contiguous block
+    class CISST_EXPORT Table
+    {
+    public:
+        //! Set number of joints, no joint is scheduled
+        void SetSize(const size_t numberOfJoints);
+
+        inline size_t size(void) const {
+            return mVariable.size();
+        }
+
+        /*! Set table for a joint.  Values must be strictly increasing
+          and all vectors must have the same, non null, size. */
+        bool SetJoint(const size_t joint, const VariableType variable,
+                      const std::vector<double> & values,
+                      const std::vector<double> & kp,
+                      const std::vector<double> & ki,
+                      const std::vector<double> & kd);
+
+        //! True if at least one joint is scheduled
+        bool Any(void) const;
+
+    protected:
+        friend class osaGainSchedule;
+        std::vector<int> mVariable;
+        //! Index of first point and number of points per joint
+        std::vector<size_t> mFirst, mCount;
+        std::vector<double> mValue, mKp, mKi, mKd;
+    };
+
+    osaGainSchedule(void);
+    ~osaGainSchedule() {}
+
+    //! Set number of joints, no joint is scheduled
+    void SetSize(const size_t numberOfJoints);
+
+    /*! Publish a new table, sizes must match.  Single writer at a
+      time, doesn't block the control loop. */
+    bool SetTable(const Table & table);
+
+    /*! Use the last published table, control loop only.  Returns true
+      if the table changed, e.g. to restore the fixed gains of joints
+      no longer scheduled. */
+    inline bool Update(void) {
+        if (!mTables.Update()) {
+            return false;
+        }
+        mActive = mTables.Front().Any();
+        return true;
+    }
+
+    //! True if at least one joint is scheduled in the table in use
+    inline bool Active(void) const {
+        return mActive;
+    }
+
+    /*! Compute gains of scheduled joints, others are left unchanged.
+      Control loop only. */
+    void Evaluate(const vctDynamicConstVectorRef<double> & position,
+                  const vctDynamicConstVectorRef<double> & user,
+                  vctDynamicVectorRef<double> kp,
+                  vctDynamicVectorRef<double> ki,
+                  vctDynamicVectorRef<double> kd) const;
+
+protected:
+    osaTripleBuffer<Table> mTables;
+    //! Set once by SetSize, used by writer
+    size_t mNumberOfJoints;
+    //! Reader only
+    bool mActive;
+};
+
+#endif // _osaGainSchedule_h
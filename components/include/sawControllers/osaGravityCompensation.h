@@ -2,6 +2,8 @@
 #ifndef _osaGravityCompensation_h
 #define _osaGravityCompensation_h
 
+#include <vector>
+
 #include <cisstRobot/robManipulator.h>
 #include <sawControllers/sawControllersExport.h>
 
@@ -11,6 +13,52 @@ class CISST_EXPORT osaGravityCompensation : public robManipulator {
 
   enum Errno{ ESUCCESS, EFAILURE };
 
+ private:
+
+  //! Use the gravity only recursive Newton-Euler
+  /**
+     Set in the constructor if the DH convention of all links is
+     supported and the result matches InverseDynamics.  Otherwise
+     Evaluate falls back to InverseDynamics.
+  */
+  bool gravityonly;
+
+ protected:
+
+  //! Gravity acceleration, opposite of the gravity vector in world frame
+  vctFixedSizeVector<double,3> gravity;
+
+  //! Mass of each link, cached in the constructor
+  std::vector<double> masses;
+  //! Center of mass of each link in link frame, cached in the constructor
+  std::vector< vctFixedSizeVector<double,3> > centers;
+  //! True for links using the modified DH convention
+  std::vector<bool> modified;
+  //! True for prismatic joints
+  std::vector<bool> prismatic;
+
+ private:
+
+  //! Workspace: joint axes, joint origins and centers of mass in world frame
+  std::vector< vctFixedSizeVector<double,3> > axes;
+  std::vector< vctFixedSizeVector<double,3> > origins;
+  std::vector< vctFixedSizeVector<double,3> > centersw;
+
+  //! Zero velocities and accelerations for InverseDynamics
+  vctDynamicVector<double> qd;
+  vctDynamicVector<double> qdd;
+
+  //! Gravity only recursive Newton-Euler
+  /**
+     Only needs the link frames and the link masses/centers of mass.
+     Doesn't allocate any memory, tau must be sized.
+  */
+  void GravityRNE( const vctDynamicVector<double>& q,
+		   vctDynamicVector<double>& tau );
+
+  //! Compare GravityRNE to InverseDynamics for a few configurations
+  bool CheckGravityRNE();
+
  public:
 
   //! Main constructor
@@ -26,7 +74,11 @@ class CISST_EXPORT osaGravityCompensation : public robManipulator {
 
   //! Evaluate the control law
   /**
-     \param[in]  qs  Desired joint positions
+     Uses a gravity only recursive Newton-Euler when possible, i.e. the
+     velocity and acceleration terms are not computed.  tau is only
+     resized if it doesn't match the number of links so no memory is
+     allocated after the first call.
+     \param[in]  q   Joint positions
      \param[out] tau Joint forces/torques
      \return     ESUCCESS if the evaluation was successful. EFAILURE otherwise
   */
@@ -34,6 +86,21 @@ class CISST_EXPORT osaGravityCompensation : public robManipulator {
     Evaluate( const vctDynamicVector<double>& q,
 	      vctDynamicVector<double>& tau );
 
+  //! Evaluate the control law using the full inverse dynamics
+  /**
+     Reference implementation, uses robManipulator::InverseDynamics
+     with zero velocities and accelerations.
+     \param[in]  q   Joint positions
+     \param[out] tau Joint forces/torques
+     \return     ESUCCESS if the evaluation was successful. EFAILURE otherwise
+  */
+  osaGravityCompensation::Errno
+    EvaluateInverseDynamics( const vctDynamicVector<double>& q,
+			     vctDynamicVector<double>& tau );
+
+  //! True if Evaluate uses the gravity only recursive Newton-Euler
+  bool UsesGravityOnly() const { return gravityonly; }
+
 };
 
 #endif
@@ -0,0 +1,153 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+/*
+
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _osaGravityCompensationN_h
+#define _osaGravityCompensationN_h
+
+#include <sstream>
+
+#include <cisstCommon/cmnThrow.h>
+#include <cisstVector/vctFixedSizeVector.h>
+#include <sawControllers/osaGravityCompensation.h>
+
+//! Gravity compensation for a number of joints known at compile time
+/**
+   Same gravity only recursive Newton-Euler as osaGravityCompensation
+   with fixed size workspaces.  If the model doesn't support the
+   gravity only RNE (see UsesGravityOnly), the joint positions are
+   copied to dynamic vectors and the full inverse dynamics are used.
+*/
+template <vct::size_type _size>
+class osaGravityCompensationN : public osaGravityCompensation {
+
+ public:
+
+  enum { DOF = _size };
+
+  typedef vctFixedSizeVector<double, _size> VectorType;
+
+ private:
+
+  //! Workspace: joint axes, joint origins and centers of mass in world frame
+  vctFixedSizeVector<double,3> axes[_size];
+  vctFixedSizeVector<double,3> origins[_size];
+  vctFixedSizeVector<double,3> centersw[_size];
+
+  //! Joint positions passed to the inverse dynamics
+  vctDynamicVector<double> qdynamic;
+  //! Joint torques computed by the inverse dynamics
+  vctDynamicVector<double> taudynamic;
+
+  //! Gravity only recursive Newton-Euler, see osaGravityCompensation
+  void GravityRNE( const VectorType& q, VectorType& tau ){
+
+    // forward recursion: joint axes, joint origins and centers of
+    // mass in world frame
+    vctFrame4x4<double> Rtwi( Rtw0 );
+    for( size_t i=0; i<_size; i++ ){
+      // standard DH: joint i moves along/about z of the previous frame
+      if( !modified[i] ){
+	axes[i].Assign( Rtwi.Rotation().Column( 2 ) );
+	origins[i].Assign( Rtwi.Translation() );
+      }
+      Rtwi = Rtwi * links[i].ForwardKinematics( q[i] );
+      // modified DH: joint i moves along/about z of its own frame
+      if( modified[i] ){
+	axes[i].Assign( Rtwi.Rotation().Column( 2 ) );
+	origins[i].Assign( Rtwi.Translation() );
+      }
+      centersw[i] = Rtwi * centers[i];
+    }
+
+    // backward recursion: accumulate the mass and first moment of
+    // mass of all the links moved by each joint
+    double mass = 0.0;
+    vctFixedSizeVector<double,3> moment( 0.0 );
+    vctFixedSizeVector<double,3> arm, torque;
+    for( size_t i=_size; 0<i; i-- ){
+      const size_t j = i-1;
+      mass += masses[j];
+      moment += masses[j] * centersw[j];
+      if( prismatic[j] )
+	{ tau[j] = mass * axes[j].DotProduct( gravity ); }
+      else{
+	arm.DifferenceOf( moment, mass * origins[j] );
+	torque.CrossProductOf( arm, gravity );
+	tau[j] = axes[j].DotProduct( torque );
+      }
+    }
+
+  }
+
+ public:
+
+  //! Main constructor
+  /**
+     Throws if the robot file doesn't have exactly DOF links.
+     \param[in] robfilename File containing the kinematics and dynamics
+                            parameters, must have exactly DOF links
+     \param[in] Rtwb        Position and orientation of the robot with resepct
+                            to world frame
+  */
+  osaGravityCompensationN( const std::string& robfile,
+			   const vctFrame4x4<double>& Rtwb ) :
+    osaGravityCompensation( robfile, Rtwb ),
+    qdynamic( _size, 0.0 ),
+    taudynamic( _size, 0.0 ){
+
+    if( links.size() != _size ){
+      std::ostringstream message;
+      message << "osaGravityCompensationN: robot file " << robfile << " has "
+	      << links.size() << " links, expected " << _size;
+      cmnThrow( message.str() );
+    }
+
+  }
+
+  using osaGravityCompensation::Evaluate;
+
+  //! Evaluate the control law
+  /**
+     Doesn't allocate memory if UsesGravityOnly.
+     \param[in]  q   Joint positions
+     \param[out] tau Joint forces/torques
+     
+eturn     ESUCCESS if the evaluation was successful. EFAILURE otherwise
+  */
+  osaGravityCompensation::Errno
+    Evaluate( const VectorType& q, VectorType& tau ){
+
+    if( UsesGravityOnly() ){
+      GravityRNE( q, tau );
+      return osaGravityCompensation::ESUCCESS;
+    }
+
+    qdynamic.Assign( q.Pointer() );
+    if( EvaluateInverseDynamics( qdynamic, taudynamic ) !=
+	osaGravityCompensation::ESUCCESS )
+      { return osaGravityCompensation::EFAILURE; }
+    tau.Assign( taudynamic.Pointer() );
+
+    return osaGravityCompensation::ESUCCESS;
+
+  }
+
+};
+
+#endif
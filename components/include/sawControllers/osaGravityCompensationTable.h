@@ -0,0 +1,180 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+/*
+
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _osaGravityCompensationTable_h
+#define _osaGravityCompensationTable_h
+
+#include <vector>
+
+#include <sawControllers/osaGravityCompensation.h>
+#include <sawControllers/sawControllersExport.h>
+
+//! Precomputed gravity torques with multilinear interpolation
+/**
+   Gravity torques are sampled on a regular grid over a few selected
+   joints, the other joints being at nominal positions.  Evaluate
+   interpolates the torques for all joints from the 2^d grid nodes
+   around the current position.
+
+   The exact model is used instead if:
+   - a grid joint is outside the grid range,
+   - a joint not on the grid is further than a tolerance from its
+     nominal position,
+   - the interpolation error at the center of the current cell was
+     above the tolerance when the table was built.
+
+   Tables can be saved to a binary file and loaded back, on POSIX
+   systems the file is memory mapped.  The file stores a hash of the
+   model (kinematics and masses of all links) and of the base frame
+   Rtw0, a table built for another robot or base is rejected.
+*/
+class CISST_EXPORT osaGravityCompensationTable {
+
+ public:
+
+  enum Errno{ ESUCCESS, EFAILURE };
+
+ private:
+
+  //! Exact model, used to build the table and as fallback
+  osaGravityCompensation* model;
+
+  //! Number of links of the model
+  size_t N;
+
+  //! Hashes of the model links and base frame, saved with the table
+  unsigned long long modelhash, basehash;
+
+  //! Indices of the joints used for the grid
+  std::vector<size_t> joints;
+  //! Grid lower and upper bounds for each grid joint
+  std::vector<double> lower, upper;
+  //! Number of samples for each grid joint
+  std::vector<size_t> samples;
+  //! Offset between two consecutive samples of each grid joint, in nodes
+  std::vector<size_t> strides;
+  //! Positions of all joints used to build the grid
+  vctDynamicVector<double> qnominal;
+  //! Maximum distance to nominal for joints not on the grid
+  double nominaltolerance;
+
+  //! True for joints on the grid
+  std::vector<bool> ongrid;
+
+  //! Torques for each node, N values per node
+  const double* torques;
+  //! Per cell flag set if the interpolation error is too high
+  const unsigned char* exact;
+
+  //! Storage used when the table is built or read without mapping
+  std::vector<double> torquesbuffer;
+  std::vector<unsigned char> exactbuffer;
+
+  //! Memory mapped file
+  void* mapping;
+  size_t mappingsize;
+
+  //! Workspace: cell and position in cell set by Locate
+  std::vector<size_t> cell;
+  std::vector<double> fractions;
+  size_t cellindex;
+
+  //! Number of nodes and cells
+  size_t NumberOfNodes() const;
+  size_t NumberOfCells() const;
+
+  //! Set strides and workspace once joints and samples are known
+  void Initialize();
+
+  //! Release memory mapped file if any
+  void Release();
+
+  //! Read the table from the content of a file
+  bool Parse( const char* data, size_t size );
+
+  //! Find cell and fractions, false if outside the grid
+  bool Locate( const vctDynamicVector<double>& q );
+
+  //! Interpolate within the cell found by Locate
+  void Interpolate( vctDynamicVector<double>& tau ) const;
+
+ public:
+
+  //! Main constructor
+  /**
+     \param[in] model Exact gravity compensation model, must outlive
+                      the table
+  */
+  osaGravityCompensationTable( osaGravityCompensation* model );
+
+  ~osaGravityCompensationTable();
+
+  //! Build the table using the exact model
+  /**
+     \param[in] joints    Indices of the joints used for the grid
+     \param[in] lower     Lower bound for each grid joint
+     \param[in] upper     Upper bound for each grid joint
+     \param[in] samples   Number of samples for each grid joint (at least 2)
+     \param[in] qnominal  Positions of all joints, values for grid joints
+                          are ignored
+     \param[in] tolerance Maximum interpolation error at the center of
+                          a cell and maximum distance to nominal for
+                          joints not on the grid
+     \return     ESUCCESS if the table was built. EFAILURE otherwise
+  */
+  osaGravityCompensationTable::Errno
+    Build( const std::vector<size_t>& joints,
+           const std::vector<double>& lower,
+           const std::vector<double>& upper,
+           const std::vector<size_t>& samples,
+           const vctDynamicVector<double>& qnominal,
+           double tolerance );
+
+  //! Save the table to a binary file
+  osaGravityCompensationTable::Errno Save( const std::string& filename ) const;
+
+  //! Load a table from a binary file
+  /**
+     The number of links and the hashes of the model and base frame
+     must match.  On POSIX systems the file is memory mapped, read
+     only.
+  */
+  osaGravityCompensationTable::Errno Load( const std::string& filename );
+
+  //! Evaluate the gravity torques
+  /**
+     Interpolated from the table or computed with the exact model,
+     see class description.
+     \param[in]  q   Joint positions
+     \param[out] tau Joint forces/torques
+     \return     ESUCCESS if the evaluation was successful. EFAILURE otherwise
+  */
+  osaGravityCompensationTable::Errno
+    Evaluate( const vctDynamicVector<double>& q,
+              vctDynamicVector<double>& tau );
+
+  //! True if q can be interpolated from the table
+  bool IsInterpolated( const vctDynamicVector<double>& q );
+
+  //! Fraction of cells using the exact model
+  double ExactCellsRatio() const;
+
+};
+
+#endif
@@ -0,0 +1,193 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Control loop timing histograms
+  \ingroup sawControllers
+*/
+
+
+#ifndef _osaLoopTiming_h
+#define _osaLoopTiming_h
+
+#include <vector>
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstVector/vctDynamicVector.h>
+
+//! Always include last
+#include <sawControllers/sawControllersExport.h>
+
+/*!
+  Histograms of the compute time, IO time and period jitter of a
+  control loop.  All methods are meant to be called from the control
+  loop thread and don't allocate memory once Configure has been
+  called.  Other threads should use the summary through a state table
+  or an event.
+
+  Typical use in a Run method:
+  \code
+  mLoopTiming.BeginTick();
+  mLoopTiming.BeginIO();
+  // read from IO
+  mLoopTiming.EndIO();
+  // compute
+  mLoopTiming.BeginIO();
+  // write to IO
+  mLoopTiming.EndIO();
+  if (mLoopTiming.EndTick()) {
+      // summary has been updated
+  }
+  \endcode
+
+  The summary is a vector of doubles, times are in seconds:
+  - SUMMARY_TICKS and SUMMARY_OVERRUNS, counted since Reset.  An
+    overrun is a tick longer than the period.
+  - for COMPUTE, IO and JITTER, starting at SUMMARY_HISTOGRAMS +
+    histogram * NUMBER_OF_STATISTICS: 50th, 99th and 99.9th
+    percentiles and maximum over one summary period.
+
+  Percentiles are upper bounds of the histogram bins, i.e. within
+  the resolution.
+
+  There are two sets of histograms.  At the end of a summary period
+  the sets are swapped and the percentiles of the previous period are
+  computed a few bins per tick during the next period, so EndTick
+  never scans all the bins at once.  The summary is therefore
+  published one summary period after the samples were collected.
+*/
+class CISST_EXPORT osaLoopTiming
+{
+public:
+    typedef enum {
+        COMPUTE = 0,
+        IO,
+        JITTER,
+        NUMBER_OF_HISTOGRAMS
+    } HistogramType;
+
+    typedef enum {
+        P50 = 0,
+        P99,
+        P999,
+        MAX,
+        NUMBER_OF_STATISTICS
+    } StatisticType;
+
+    typedef enum {
+        SUMMARY_TICKS = 0,
+        SUMMARY_OVERRUNS,
+        SUMMARY_HISTOGRAMS,
+        SUMMARY_SIZE = SUMMARY_HISTOGRAMS + NUMBER_OF_HISTOGRAMS * NUMBER_OF_STATISTICS
+    } SummaryIndexType;
+
+    osaLoopTiming(void);
+    ~osaLoopTiming() {}
+
+    /*! Allocate the histograms.  The summary is updated every
+      ticksPerSummary ticks, if 0 the number of ticks in a second is
+      used. */
+    void Configure(const double period,
+                   const size_t ticksPerSummary = 0,
+                   const double resolution = 1.0 * cmn_us,
+                   const size_t numberOfBins = 5000);
+
+    //! Clear histograms and counters
+    void Reset(void);
+
+    void BeginTick(void);
+    void BeginIO(void);
+    void EndIO(void);
+
+    /*! Update the histograms, returns true when the summary has been
+      updated. */
+    bool EndTick(void);
+
+    //! Summary, size is SUMMARY_SIZE
+    inline vctDynamicVector<double> & Summary(void) {
+        return mSummary;
+    }
+
+    inline double Statistic(const HistogramType histogram,
+                            const StatisticType statistic) const {
+        return mSummary[SUMMARY_HISTOGRAMS + histogram * NUMBER_OF_STATISTICS + statistic];
+    }
+
+protected:
+    class Histogram {
+    public:
+        Histogram(void): mResolution(1.0), mCount(0), mMax(0.0), mScanBin(0), mScanCumulated(0) {}
+        void Configure(const double resolution, const size_t numberOfBins);
+        void Clear(void);
+        //! Add a sample, last bin counts all samples above range
+        void Add(const double value);
+        inline size_t NumberOfBins(void) const {
+            return mBins.size();
+        }
+        //! Prepare the percentile targets, then call Scan until it returns true
+        void BeginScan(void);
+        /*! Scan and clear at most numberOfBins bins, numberOfBins is
+          decremented by the number of bins scanned.  Returns true
+          once all bins have been scanned, the statistics are then
+          available and the histogram is empty. */
+        bool Scan(size_t & numberOfBins);
+        inline double Statistic(const StatisticType statistic) const {
+            return mStatistics[statistic];
+        }
+    protected:
+        double mResolution;
+        std::vector<unsigned int> mBins;
+        size_t mCount;
+        double mMax;
+        size_t mScanBin;
+        size_t mScanCumulated;
+        size_t mTargets[MAX];
+        double mStatistics[NUMBER_OF_STATISTICS];
+    };
+
+    //! Samples are added to mHistograms[mActive], the other set is scanned
+    Histogram mHistograms[2][NUMBER_OF_HISTOGRAMS];
+    size_t mActive;
+    bool mScanning;
+    size_t mScanHistogram;
+    size_t mBinsPerTick;
+
+    double mPeriod;
+    size_t mTicksPerSummary;
+    size_t mTicksSinceSummary;
+    size_t mTicks;
+    size_t mOverruns;
+    size_t mScanTicks;
+    size_t mScanOverruns;
+
+    double mTickStart;
+    double mPreviousTickStart;
+    double mIOStart;
+    double mIOTime;
+
+    vctDynamicVector<double> mSummary;
+
+    //! Swap the histogram sets and start scanning the previous period
+    void BeginSummary(void);
+    //! Scan mBinsPerTick bins, returns true when the summary has been updated
+    bool ContinueSummary(void);
+};
+
+#endif // _osaLoopTiming_h
@@ -2,10 +2,10 @@
 #ifndef _osaPDGC_h
 #define _osaPDGC_h
 
-#include <cisstRobot/robManipulator.h>
+#include <sawControllers/osaGravityCompensation.h>
 #include <sawControllers/sawControllersExport.h>
 
-class CISST_EXPORT osaPDGC : public robManipulator {
+class CISST_EXPORT osaPDGC : public osaGravityCompensation {
 
  public:
 
@@ -23,6 +23,24 @@ class CISST_EXPORT osaPDGC : public robManipulator {
   //! Old error
   vctDynamicVector<double> eold;
 
+  //! Workspace: error and error time derivative
+  vctDynamicVector<double> e;
+  vctDynamicVector<double> ed;
+
+  //! Diagonals of the gain matrices
+  vctDynamicVector<double> Kpdiag;
+  vctDynamicVector<double> Kddiag;
+
+  //! Number of non zero diagonals above/below the main diagonal of Kp and Kd
+  /**
+     0 for diagonal gains, N-1 for dense gains.  Only the elements
+     within the band are used in Evaluate.
+  */
+  size_t bandwidth;
+
+  //! Find the bandwidth of the gain matrices
+  void UpdateBandwidth();
+
  public:
 
   //! Main constructor
@@ -34,6 +52,10 @@ class CISST_EXPORT osaPDGC : public robManipulator {
      \param[in] Kp          NxN matrix of proportional gains
      \param[in] Kd          NxN matrix of derivative gains
      \param[in] qinit       Initial joint positions
+
+     Gravity is computed by osaGravityCompensation.  The bandwidth of
+     the gain matrices is detected so diagonal gains are applied in
+     O(N).
   */
   osaPDGC( const std::string& robfilename, 
 	   const vctFrame4x4<double>& Rtwb,
@@ -43,6 +65,7 @@ class CISST_EXPORT osaPDGC : public robManipulator {
   
   //! Evaluate the control law
   /**
+     Doesn't allocate any memory once tau is sized.
      \param[in]  qs  Desired joint positions
      \param[in]  q   Current joint positions
      \param[out] tau Joint forces/torques
@@ -55,6 +78,14 @@ class CISST_EXPORT osaPDGC : public robManipulator {
 	      vctDynamicVector<double>& tau,
 	      double dt );
 
+  //! Set the gain matrices, the bandwidth is detected again
+  osaPDGC::Errno
+    SetGains( const vctDynamicMatrix<double>& Kp,
+	      const vctDynamicMatrix<double>& Kd );
+
+  //! Bandwidth of the gain matrices, 0 if diagonal
+  size_t GetBandwidth() const { return bandwidth; }
+
 };
 
 #endif
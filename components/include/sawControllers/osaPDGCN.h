@@ -0,0 +1,118 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+/*
+
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _osaPDGCN_h
+#define _osaPDGCN_h
+
+#include <cisstVector/vctFixedSizeMatrix.h>
+#include <sawControllers/osaGravityCompensationN.h>
+
+//! PD with gravity compensation for a number of joints known at compile time
+/**
+   Same control law as osaPDGC, i.e. tau = G(q) - Kp e - Kd ed, using
+   fixed size vectors and matrices.  The gravity load is provided by
+   osaGravityCompensationN since the Coriolis/centrifugal terms of
+   osaPDGC are evaluated at zero velocity.
+*/
+template <vct::size_type _size>
+class osaPDGCN : public osaGravityCompensationN<_size> {
+
+ public:
+
+  enum Errno{ ESUCCESS, EFAILURE };
+
+  typedef vctFixedSizeVector<double, _size> VectorType;
+  typedef vctFixedSizeMatrix<double, _size, _size> MatrixType;
+
+ private:
+
+  //! Proportional gains
+  MatrixType Kp;
+  //! Derivative gains
+  MatrixType Kd;
+
+  //! Old error
+  VectorType eold;
+
+  //! Error and error time derivative workspace
+  VectorType e, ed;
+
+ public:
+
+  //! Main constructor
+  /**
+     \param[in] robfilename File containing the kinematics and dynamics
+                            parameters, must have exactly _size links
+     \param[in] Rtwb        Position and orientation of the robot with resepct
+                            to world frame
+     \param[in] Kp          NxN matrix of proportional gains
+     \param[in] Kd          NxN matrix of derivative gains
+  */
+  osaPDGCN( const std::string& robfilename,
+	    const vctFrame4x4<double>& Rtwb,
+	    const MatrixType& Kp,
+	    const MatrixType& Kd ) :
+    osaGravityCompensationN<_size>( robfilename, Rtwb ),
+    Kp( Kp ),
+    Kd( Kd ),
+    eold( 0.0 ),
+    e( 0.0 ),
+    ed( 0.0 ){}
+
+  //! Evaluate the control law
+  /**
+     \param[in]  qs  Desired joint positions
+     \param[in]  q   Current joint positions
+     \param[out] tau Joint forces/torques
+     \param      dt  Time interval
+     \return     ESUCCESS if the evaluation was successful. EFAILURE otherwise
+  */
+  Errno Evaluate( const VectorType& qs,
+		  const VectorType& q,
+		  VectorType& tau,
+		  double dt ){
+
+    // error = current - desired
+    e.DifferenceOf( q, qs );
+
+    // error time derivative
+    if( 0 < dt ){
+      ed.DifferenceOf( e, eold );
+      ed.Divide( dt );
+    }
+    else
+      { ed.SetAll( 0.0 ); }
+
+    // gravity load
+    if( osaGravityCompensationN<_size>::Evaluate( q, tau ) !=
+	osaGravityCompensation::ESUCCESS )
+      { return EFAILURE; }
+
+    tau.Subtract( Kp * e );
+    tau.Subtract( Kd * ed );
+
+    eold.Assign( e );
+
+    return ESUCCESS;
+
+  }
+
+};
+
+#endif
@@ -22,6 +22,8 @@
 #define _osaPIDAntiWindup_h
 
 #include <cisstVector/vctDynamicVector.h>
+#include <cisstVector/vctDynamicVectorRef.h>
+#include <cisstVector/vctDynamicConstVectorRef.h>
 #include <sawControllers/sawControllersExport.h>
 
 class CISST_EXPORT osaPIDAntiWindup {
@@ -62,6 +64,12 @@ class CISST_EXPORT osaPIDAntiWindup {
   //! Old error
   vctDynamicVector<double> eold;
 
+  //! Error workspace, sized in the constructor
+  vctDynamicVector<double> e;
+
+  //! Error time derivative workspace, sized in the constructor
+  vctDynamicVector<double> ed;
+
  protected:
 
 
@@ -90,11 +98,30 @@ class CISST_EXPORT osaPIDAntiWindup {
      \param[out] tau Joint forces/torques
      \param      dt  Time interval
      \return     ESUCCESS if the evaluation was successful. EFAILURE otherwise
+
+     tau is resized if it doesn't match the number of joints, this
+     only allocates memory on the first call.
   */
   osaPIDAntiWindup::Errno Evaluate( const vctDynamicVector<double>& qs,
                                     const vctDynamicVector<double>& q,
                                     vctDynamicVector<double>& tau,
                                     double dt );
+
+  //! Evaluate the control law in place
+  /**
+     Same as above but the joint forces/torques are written in a view
+     provided by the caller.  This method doesn't allocate any memory
+     and can be used in a real-time loop.
+     \param[in]  qs  Desired joint positions
+     \param[in]  q   Current joint positions
+     \param[out] tau Joint forces/torques, must be sized to the number of joints
+     \param      dt  Time interval
+     \return     ESUCCESS if the evaluation was successful. EFAILURE otherwise
+  */
+  osaPIDAntiWindup::Errno Evaluate( const vctDynamicConstVectorRef<double>& qs,
+                                    const vctDynamicConstVectorRef<double>& q,
+                                    vctDynamicVectorRef<double> tau,
+                                    double dt );
   
 };
 
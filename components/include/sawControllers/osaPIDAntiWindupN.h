@@ -0,0 +1,143 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-  */
+/*ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab:*/
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+  --- begin cisst license - do not edit ---
+
+  This software is provided "as is" under an open source license, with
+  no warranty.  The complete license can be found in license.txt and
+  http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _osaPIDAntiWindupN_h
+#define _osaPIDAntiWindupN_h
+
+#include <cmath>
+#include <iostream>
+
+#include <cisstVector/vctFixedSizeVector.h>
+
+//! PID with anti-windup for a number of joints known at compile time
+/**
+   Same control law as osaPIDAntiWindup but all vectors are fixed size
+   so the compiler can unroll the per-joint loop and no memory is
+   allocated.  For example, osaPIDAntiWindupN<7> for a WAM.
+*/
+template <vct::size_type _size>
+class osaPIDAntiWindupN {
+
+ public:
+
+  enum Errno{ ESUCCESS, EFAILURE };
+
+  enum { DOF = _size };
+
+  typedef vctFixedSizeVector<double, _size> VectorType;
+
+ private:
+
+  //! Vector of proportional gains
+  VectorType Kp;
+
+  //! Vector of integral gains
+  VectorType Ki;
+
+  //! Vector of derivative gains
+  VectorType Kd;
+
+  //! Vector of anti-windup gains
+  VectorType Kt;
+
+  //! Integral accumulator
+  VectorType I;
+
+  //! Controller command
+  VectorType commands;
+
+  //! Controller output
+  VectorType outputs;
+
+  //! Plant limits
+  VectorType limits;
+
+  //! Old error
+  VectorType eold;
+
+ public:
+
+  //! Main constructor
+  /**
+     \param[in]  Kp Vector of proportional gains
+     \param[in]  Ki Vector of integral gains
+     \param[in]  Kd Vector of derivative gains
+     \param[in]  Kt Vector of anti-windup gains
+     \param[in]  limits Vector of plant limits
+  */
+  osaPIDAntiWindupN( const VectorType& Kp,
+                     const VectorType& Ki,
+                     const VectorType& Kd,
+                     const VectorType& Kt,
+                     const VectorType& limits ) :
+    Kp( Kp ),
+    Ki( Ki ),
+    Kd( Kd ),
+    Kt( Kt ),
+    I( 0.0 ),
+    commands( 0.0 ),
+    outputs( 0.0 ),
+    eold( 0.0 ){
+    for( size_t i=0; i<_size; i++ )
+      { this->limits[i] = fabs( limits[i] ); }
+  }
+
+  //! Evaluate the control law
+  /**
+     \param[in]  qs  Desired joint positions
+     \param[in]  q   Current joint positions
+     \param[out] tau Joint forces/torques
+     \param      dt  Time interval
+     \return     ESUCCESS if the evaluation was successful. EFAILURE otherwise
+  */
+  Errno Evaluate( const VectorType& qs,
+                  const VectorType& q,
+                  VectorType& tau,
+                  double dt ){
+
+    if( dt <= 0 ){
+      std::cerr << "Invalid time increment: " << dt << std::endl;
+      return EFAILURE;
+    }
+
+    for( size_t i=0; i<_size; i++ ){
+      // error = desired - current and its time derivative
+      const double e  = qs[i] - q[i];
+      const double ed = ( e - eold[i] ) / dt;
+
+      // command with anti windup
+      I[i] += ( Ki[i]*e + Kt[i]*(outputs[i]-commands[i]) ) * dt;
+      commands[i] = Kp[i]*e + Kd[i]*ed + I[i];
+
+      // saturate the output
+      double output = commands[i];
+      if( output < -limits[i] ) { output = -limits[i]; }
+      if( limits[i]  < output ) { output =  limits[i]; }
+      outputs[i] = output;
+      tau[i] = output;
+
+      eold[i] = e;
+    }
+
+    return ESUCCESS;
+
+  }
+
+};
+
+#endif
@@ -0,0 +1,152 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Parsed PID configuration and compiled configuration files
+  \ingroup sawControllers
+*/
+
+
+#ifndef _osaPIDConfiguration_h
+#define _osaPIDConfiguration_h
+
+#include <string>
+#include <vector>
+
+#include <cisstParameterTypes/prmJointType.h>
+#include <sawControllers/osaVelocityEstimator.h>
+#include <sawControllers/osaDerivativeFilter.h>
+#include <sawControllers/osaSetpointInterpolator.h>
+#include <sawControllers/osaGainSchedule.h>
+
+//! Always include last
+#include <sawControllers/sawControllersExport.h>
+
+class cmnXMLPath;
+
+/*!
+  Content of a mtsPID XML configuration file (see mtsPID::Configure
+  for the format), parsed and validated once.  Values are in SI units,
+  i.e. position limits are already converted.  Missing values use the
+  same defaults as mtsPID.
+
+  A parsed configuration can be saved in a compiled, binary file and
+  loaded back without parsing XML.  Compiled files contain the format
+  VERSION and the hash of the XML file they were created from,
+  LoadCompiled fails if either doesn't match so the caller can fall
+  back to the XML file.  Compiled files are meant to be used on the
+  host that created them (native byte order).
+*/
+class CISST_EXPORT osaPIDConfiguration
+{
+public:
+    //! Format of compiled files, to be incremented when data members change
+    enum {VERSION = 2};
+
+    //! Parameters for one joint
+    class CISST_EXPORT Joint
+    {
+    public:
+        Joint(void);
+
+        prmJointType Type;
+        std::string Name;
+
+        // pid
+        double PGain, DGain, IGain, OffsetTorque, Forget, Nonlinear;
+        double VelocityFeedForward, AccelerationFeedForward;
+
+        // limit
+        double MinILimit, MaxILimit, ErrorLimit, Deadband;
+
+        // velocity estimation
+        osaVelocityEstimator::FilterType VelocityFilter;
+        double VelocityCutoff, VelocityNoiseLevel;
+        int VelocityWindow, VelocityOrder;
+
+        // derivative filter
+        osaDerivativeFilter::FilterType DerivativeFilter;
+        double DerivativeCutoff, DerivativeProcessNoise, DerivativeMeasurementNoise;
+
+        // trajectory, all or none
+        bool HasTrajectoryLimits;
+        double MaxVelocity, MaxAcceleration, MaxJerk;
+
+        // position limits, all or none
+        bool HasPositionLimits;
+        double PositionLowerLimit, PositionUpperLimit;
+
+        // simulated plant, see osaSimulatedPlant
+        double PlantMass, PlantDamping, PlantFriction, PlantBacklash;
+
+        // gain schedule, NONE if the joint is not scheduled
+        osaGainSchedule::VariableType ScheduleVariable;
+        std::vector<double> ScheduleValues, SchedulePGains, ScheduleIGains, ScheduleDGains;
+    };
+
+    osaPIDConfiguration(void);
+    ~osaPIDConfiguration() {}
+
+    //! Parse and validate an XML file
+    bool LoadXML(const std::string & filename);
+
+    /*! Parse only gain schedule tables from an XML file, for the
+      joints already defined. */
+    bool LoadGainScheduleXML(const std::string & filename);
+
+    //! Build gain schedule tables for all active joints
+    bool GainSchedule(osaGainSchedule::Table & table) const;
+
+    //! Load a compiled file, fails if the hash or version don't match
+    bool LoadCompiled(const std::string & filename, const unsigned long long xmlHash);
+
+    //! Save a compiled file, replaces any existing file
+    bool SaveCompiled(const std::string & filename, const unsigned long long xmlHash) const;
+
+    //! Hash of a file's content
+    static bool FileHash(const std::string & filename, unsigned long long & hash);
+
+    //! State table sizes, 0 to keep the current size
+    int StateTableSize, ConfigurationStateTableSize;
+
+    //! All joints, active joints first.  Inactive joints only have a type.
+    std::vector<Joint> Joints;
+    size_t NumberOfActiveJoints;
+
+    osaSetpointInterpolator::InterpolationType Interpolation;
+    double InterpolationMaxInterval;
+
+    double TelemetryBufferDuration;
+    double EventMinimumInterval;
+
+    //! Maximum sub step for the simulated plant
+    double SimulationSubStep;
+
+protected:
+    //! Read schedule tables for all active joints
+    bool ReadGainSchedule(cmnXMLPath & config);
+
+    //! Serialize all data members, used by SaveCompiled
+    void ToBinary(std::string & buffer) const;
+    //! Deserialize data members, false if the buffer is too short or invalid
+    bool FromBinary(const std::string & buffer);
+};
+
+#endif // _osaPIDConfiguration_h
@@ -0,0 +1,162 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Joint PID kernel used by mtsPID
+  \ingroup sawControllers
+*/
+
+
+#ifndef _osaPIDKernel_h
+#define _osaPIDKernel_h
+
+#include <cisstVector/vctDynamicVector.h>
+#include <cisstVector/vctDynamicVectorRef.h>
+
+//! Always include last
+#include <sawControllers/sawControllersExport.h>
+
+/*!
+  Structure-of-arrays PID kernel.  All gains, limits, modes, inputs,
+  outputs and internal state are stored in a single block of memory,
+  one row of doubles per field.  Each row starts on a cache line
+  boundary so the per-joint loop in Evaluate can be vectorized across
+  joints.  Flags are stored as doubles, 0.0 for false and 1.0 for
+  true, to avoid branches in the loop.
+
+  The kernel doesn't know anything about arms, a caller can evaluate
+  any contiguous range of joints or all joints of several arms at once
+  (see mtsPIDMulti).
+*/
+class CISST_EXPORT osaPIDKernel
+{
+public:
+    typedef enum {
+        // configuration
+        KP = 0,
+        KI,
+        KD,
+        OFFSET,
+        DEADBAND,
+        IERROR_LIMIT_MIN,
+        IERROR_LIMIT_MAX,
+        IERROR_FORGET_FACTOR,
+        NONLINEAR,
+        EFFORT_LOWER_LIMIT,
+        EFFORT_UPPER_LIMIT,
+        TRACKING_ERROR_TOLERANCE,
+        VELOCITY_FEEDFORWARD,
+        ACCELERATION_FEEDFORWARD,
+        // modes
+        ENABLED,
+        EFFORT_MODE,
+        TRACKING_ERROR_ENABLED,
+        APPLY_EFFORT_LIMIT,
+        POSITION_LIMIT,
+        // inputs
+        MEASURED_POSITION,
+        MEASURED_VELOCITY,
+        USER_EFFORT,
+        COMMAND_VELOCITY,
+        COMMAND_ACCELERATION,
+        //! Added to PID effort, e.g. from a dynamic model
+        FEEDFORWARD_EFFORT,
+        // input and output, replaced by measured position if not in PID mode
+        COMMAND_POSITION,
+        // output
+        COMMAND_EFFORT,
+        // state
+        POSITION_ERROR,
+        INTEGRAL_ERROR,
+        TRACKING_ERROR,
+        PREVIOUS_TRACKING_ERROR,
+        TRACKING_ERROR_NOW,
+        //! Tracking error not present on the previous evaluation
+        TRACKING_ERROR_NEW,
+        NUMBER_OF_FIELDS
+    } FieldType;
+
+    osaPIDKernel(void);
+    ~osaPIDKernel() {}
+
+    /*! Allocate and initialize memory for a given number of joints.
+      All fields are set to 0 except the integral limits (set to
+      -/+ max double) and the forget factors (set to 1). */
+    void SetSize(const size_t numberOfJoints);
+
+    inline size_t size(void) const {
+        return mSize;
+    }
+
+    //! View on a field for all joints
+    inline vctDynamicVectorRef<double> Field(const FieldType field) {
+        return vctDynamicVectorRef<double>(mSize, mData + field * mStride);
+    }
+
+    //! View on a field for a range of joints
+    inline vctDynamicVectorRef<double> Field(const FieldType field,
+                                             const size_t first,
+                                             const size_t count) {
+        return vctDynamicVectorRef<double>(count, mData + field * mStride + first);
+    }
+
+    //! Raw pointer on first element of a field
+    inline double * Pointer(const FieldType field) {
+        return mData + field * mStride;
+    }
+
+    inline const double * Pointer(const FieldType field) const {
+        return mData + field * mStride;
+    }
+
+    /*! Reset position errors, integral errors and tracking error
+      flags for a range of joints. */
+    void Reset(const size_t first, const size_t count);
+
+    /*! Evaluate the PID for a range of joints.  Returns true if any of
+      the joints is above its tracking error tolerance.
+      newTrackingError is set to true if any of the joints wasn't in
+      tracking error on the previous evaluation. */
+    bool Evaluate(const size_t first, const size_t count,
+                  bool & newTrackingError);
+
+    //! Evaluate the PID for all joints
+    inline bool Evaluate(bool & newTrackingError) {
+        return Evaluate(0, mSize, newTrackingError);
+    }
+
+    /*! Tracking errors found by the last evaluation for a range of
+      joints, same results as Evaluate for that range.  Used when
+      several arms are evaluated at once. */
+    bool TrackingError(const size_t first, const size_t count,
+                       bool & newTrackingError) const;
+
+protected:
+    //! Number of joints
+    size_t mSize;
+    //! Number of doubles between two fields, multiple of a cache line
+    size_t mStride;
+    //! Memory block, over allocated to align rows
+    vctDynamicVector<double> mBlock;
+    //! Aligned first element in mBlock
+    double * mData;
+};
+
+#endif // _osaPIDKernel_h
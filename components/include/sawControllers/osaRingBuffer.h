@@ -0,0 +1,151 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Lock-free single producer, single consumer ring buffer
+  \ingroup sawControllers
+*/
+
+
+#ifndef _osaRingBuffer_h
+#define _osaRingBuffer_h
+
+#include <algorithm>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*!
+  Fixed size records of doubles passed from one producer thread
+  (usually the control loop) to one consumer thread without locks.
+  The producer reserves a record, fills it and commits it; the
+  consumer peeks at the committed records and releases them once
+  used.  Neither side blocks nor allocates, Reserve returns 0 if the
+  ring buffer is full.
+
+  Head and tail are counters, only the producer writes the head and
+  only the consumer writes the tail, each with release semantic and
+  read by the other side with acquire semantic.  Load and Store are
+  public so the owners can use the same accesses for their flags.
+  See osaEventChannel and osaTelemetryRecorder.
+*/
+class osaRingBuffer
+{
+public:
+#if defined(_MSC_VER)
+    typedef __int64 IndexType;
+    static inline IndexType Load(const IndexType & value) {
+        return _InterlockedCompareExchange64(const_cast<volatile IndexType *>(&value), 0, 0);
+    }
+    static inline void Store(IndexType & destination, const IndexType value) {
+        _InterlockedExchange64(&destination, value);
+    }
+#else
+    typedef unsigned long long IndexType;
+    static inline IndexType Load(const IndexType & value) {
+        return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+    }
+    static inline void Store(IndexType & destination, const IndexType value) {
+        __atomic_store_n(&destination, value, __ATOMIC_RELEASE);
+    }
+#endif
+
+    osaRingBuffer(void):
+        mRecordSize(0),
+        mCapacity(0),
+        mHead(0),
+        mTail(0)
+    {}
+
+    /*! Allocate and touch the buffer, not thread safe, neither side
+      can be running. */
+    void Configure(const size_t recordSize, const size_t capacity) {
+        mRecordSize = recordSize;
+        mCapacity = (capacity > 0) ? capacity : 1;
+        mBuffer.resize(mCapacity * mRecordSize);
+        std::fill(mBuffer.begin(), mBuffer.end(), 0.0);
+        mHead = 0;
+        mTail = 0;
+    }
+
+    inline size_t RecordSize(void) const {
+        return mRecordSize;
+    }
+
+    inline size_t Capacity(void) const {
+        return mCapacity;
+    }
+
+    /*! Next record to fill, 0 if the ring buffer is full.  Producer
+      only. */
+    inline double * Reserve(void) {
+        const IndexType head = mHead;
+        if (static_cast<size_t>(head - Load(mTail)) >= mCapacity) {
+            return 0;
+        }
+        return &(mBuffer[static_cast<size_t>(head % mCapacity) * mRecordSize]);
+    }
+
+    //! Publish the record returned by Reserve.  Producer only.
+    inline void Commit(void) {
+        Store(mHead, mHead + 1);
+    }
+
+    /*! Committed records, contiguous up to the end of the ring
+      buffer.  count is 0 if there is nothing to consume.  Consumer
+      only. */
+    inline const double * Peek(size_t & count) const {
+        const IndexType tail = mTail;
+        count = static_cast<size_t>(Load(mHead) - tail);
+        if (count == 0) {
+            return 0;
+        }
+        const size_t index = static_cast<size_t>(tail % mCapacity);
+        if (index + count > mCapacity) {
+            count = mCapacity - index;
+        }
+        return &(mBuffer[index * mRecordSize]);
+    }
+
+    //! Give records back to the producer.  Consumer only.
+    inline void Release(const size_t count) {
+        Store(mTail, mTail + count);
+    }
+
+    /*! Skip all committed records, e.g. records committed while the
+      consumer wasn't running.  Consumer only. */
+    inline void Skip(void) {
+        Store(mTail, Load(mHead));
+    }
+
+protected:
+    size_t mRecordSize;
+    size_t mCapacity;
+    std::vector<double> mBuffer;
+
+    //! Number of records committed by the producer
+    IndexType mHead;
+    //! Number of records released by the consumer
+    IndexType mTail;
+};
+
+#endif // _osaRingBuffer_h
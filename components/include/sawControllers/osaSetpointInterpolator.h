@@ -0,0 +1,144 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Interpolation between sparse joint setpoints
+  \ingroup sawControllers
+*/
+
+
+#ifndef _osaSetpointInterpolator_h
+#define _osaSetpointInterpolator_h
+
+#include <cisstVector/vctDynamicVector.h>
+#include <cisstVector/vctDynamicVectorRef.h>
+#include <cisstVector/vctDynamicConstVectorRef.h>
+
+//! Always include last
+#include <sawControllers/sawControllersExport.h>
+
+/*!
+  Generates a smooth joint reference at the control rate from
+  setpoints received at a lower rate.  When a setpoint is received,
+  a new segment starts from the current reference and reaches the
+  setpoint after the interval between the last two setpoint
+  timestamps, i.e. the reference lags the setpoints by one interval.
+  If no new setpoint is received by the end of the segment, the
+  reference keeps moving with the velocity at the end of the segment
+  and decelerates linearly to rest over the maximum interval, so a
+  late setpoint doesn't cause a velocity step.
+
+  - LINEAR: constant velocity over the segment, continuous position.
+  - CUBIC_HERMITE: continuous position and velocity.  The velocity at
+    the end of the segment is either provided with the setpoint or
+    the finite difference of the last two setpoints.
+  - QUINTIC: continuous position, velocity and acceleration.
+
+  If the interval between two setpoints is longer than the maximum
+  interval (e.g. first setpoint after a pause), the reference jumps
+  to the setpoint.  Segments are stored as quintic polynomials for
+  all types so Evaluate is one loop over all joints.
+*/
+class CISST_EXPORT osaSetpointInterpolator
+{
+public:
+    typedef enum {
+        NONE = 0,
+        LINEAR,
+        CUBIC_HERMITE,
+        QUINTIC
+    } InterpolationType;
+
+    osaSetpointInterpolator(void);
+    ~osaSetpointInterpolator() {}
+
+    /*! Set number of joints, interpolation type, the shortest
+      (usually the control period) and longest intervals between
+      setpoints. */
+    void Configure(const size_t numberOfJoints,
+                   const InterpolationType type,
+                   const double minInterval,
+                   const double maxInterval);
+
+    inline InterpolationType Type(void) const {
+        return mType;
+    }
+
+    //! Set reference at rest on a given position, e.g. measured position
+    void Reset(const vctDynamicConstVectorRef<double> & position);
+
+    /*! Start a new segment towards a setpoint.  The velocity is
+      optional (size 0). */
+    void SetGoal(const vctDynamicConstVectorRef<double> & goal,
+                 const vctDynamicConstVectorRef<double> & velocity,
+                 const double timestamp,
+                 const double now);
+
+    //! Reference at a given time, doesn't allocate memory
+    void Evaluate(const double now,
+                  vctDynamicVectorRef<double> position,
+                  vctDynamicVectorRef<double> velocity,
+                  vctDynamicVectorRef<double> acceleration);
+
+protected:
+    enum {NUMBER_OF_COEFFICIENTS = 6};
+
+    /*! Reference at time t from start of segment, past the end of
+      the segment the end velocity is ramped down to zero over the
+      maximum interval. */
+    void EvaluateReference(const double t,
+                           vctDynamicVectorRef<double> position,
+                           vctDynamicVectorRef<double> velocity,
+                           vctDynamicVectorRef<double> acceleration);
+
+    //! Reference at time t from start of segment, clamped to the segment
+    void EvaluateSegment(double t,
+                         vctDynamicVectorRef<double> position,
+                         vctDynamicVectorRef<double> velocity,
+                         vctDynamicVectorRef<double> acceleration);
+
+    //! Polynomial coefficient c_k for all joints
+    inline vctDynamicVectorRef<double> Coefficients(const size_t k) {
+        return vctDynamicVectorRef<double>(mNumberOfJoints, mCoefficients.Pointer(k * mNumberOfJoints));
+    }
+
+    InterpolationType mType;
+    size_t mNumberOfJoints;
+    double mMinInterval;
+    double mMaxInterval;
+
+    // last setpoint
+    vctDynamicVector<double> mGoal;
+    vctDynamicVector<double> mGoalVelocity;
+    double mGoalTimestamp;
+    bool mHasGoal;
+
+    // current reference, updated by Evaluate
+    vctDynamicVector<double> mPosition;
+    vctDynamicVector<double> mVelocity;
+    vctDynamicVector<double> mAcceleration;
+
+    // segment
+    vctDynamicVector<double> mCoefficients;
+    double mSegmentStart;
+    double mSegmentDuration;
+};
+
+#endif // _osaSetpointInterpolator_h
@@ -0,0 +1,156 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Simulated joint dynamics for controller tests
+  \ingroup sawControllers
+*/
+
+
+#ifndef _osaSimulatedPlant_h
+#define _osaSimulatedPlant_h
+
+#include <cisstVector/vctDynamicVector.h>
+#include <cisstVector/vctDynamicVectorRef.h>
+#include <cisstVector/vctDynamicConstVectorRef.h>
+
+//! Always include last
+#include <sawControllers/sawControllersExport.h>
+
+/*!
+  Joints driven by efforts, used to exercise a controller in
+  simulation.  Each joint has:
+
+  - Mass: mass or inertia, must be positive.  Joints are decoupled
+    unless a Model is provided.
+  - Damping: viscous friction, integrated implicitly so large values
+    remain stable.
+  - Friction: Coulomb friction.  A joint at rest only starts moving if
+    the applied effort is above the friction and stops when friction
+    would reverse its velocity.
+  - Backlash: total play between the actuated side and the measured
+    side.  The measured position only moves when the actuated side
+    reaches either end of the play.
+
+  A Model can replace the per joint masses with full dynamics (e.g.
+  mass matrix and gravity from a robManipulator).  It receives the net
+  efforts (applied effort minus damping and friction) and returns
+  accelerations.  With a model, friction only applies to moving
+  joints.
+
+  Step integrates over a duration using fixed size sub steps
+  (semi-implicit Euler).  Step doesn't allocate memory.  Durations
+  longer than the maximum duration (e.g. after the control loop has
+  been paused) are clamped so a single Step has a bounded number of
+  sub steps, the time not simulated is returned to the caller.
+*/
+class CISST_EXPORT osaSimulatedPlant
+{
+public:
+    //! Forward dynamics, called at every sub step, must not allocate
+    class Model {
+    public:
+        virtual ~Model() {}
+        virtual void Evaluate(const vctDynamicConstVectorRef<double> & position,
+                              const vctDynamicConstVectorRef<double> & velocity,
+                              const vctDynamicConstVectorRef<double> & effort,
+                              vctDynamicVectorRef<double> acceleration) = 0;
+    };
+
+    osaSimulatedPlant(void);
+    ~osaSimulatedPlant() {}
+
+    //! Set number of joints, unit masses, no friction nor backlash
+    void SetSize(const size_t numberOfJoints);
+
+    inline size_t size(void) const {
+        return mMass.size();
+    }
+
+    /*! Mass must be positive, damping, friction and backlash can't be
+      negative. */
+    bool SetJoint(const size_t joint, const double mass, const double damping,
+                  const double friction, const double backlash);
+
+    //! Use full dynamics instead of per joint masses, 0 to remove
+    inline void SetModel(Model * model) {
+        mModel = model;
+    }
+
+    //! Maximum duration of sub steps, must be positive
+    bool SetSubStep(const double subStep);
+
+    //! Longest duration simulated by Step, must be positive
+    bool SetMaximumDuration(const double duration);
+
+    inline double MaximumDuration(void) const {
+        return mMaximumDuration;
+    }
+
+    //! Set positions, joints at rest and centered in their backlash
+    void Reset(const vctDynamicConstVectorRef<double> & position);
+
+    //! Efforts applied on all joints until next call
+    inline void SetEffort(const vctDynamicConstVectorRef<double> & effort) {
+        mEffort.Assign(effort);
+    }
+
+    //! No effort applied, e.g. when the controller is disabled
+    inline void ClearEffort(void) {
+        mEffort.SetAll(0.0);
+    }
+
+    /*! Integrate, durations less or equal to zero are ignored.
+      Returns the time not simulated if the duration was longer than
+      the maximum duration, 0 otherwise. */
+    double Step(const double duration);
+
+    //! Measured positions, i.e. after backlash
+    inline const vctDynamicVector<double> & Position(void) const {
+        return mPosition;
+    }
+
+    //! Velocities of the actuated side
+    inline const vctDynamicVector<double> & Velocity(void) const {
+        return mVelocity;
+    }
+
+    inline const vctDynamicVector<double> & Effort(void) const {
+        return mEffort;
+    }
+
+protected:
+    void SubStep(const double step);
+
+    vctDynamicVector<double> mMass, mDamping, mFriction, mBacklash;
+    Model * mModel;
+    double mSubStep;
+    double mMaximumDuration;
+
+    vctDynamicVector<double> mEffort;
+    //! Actuated side
+    vctDynamicVector<double> mActuatedPosition, mVelocity;
+    //! Measured side
+    vctDynamicVector<double> mPosition;
+    //! Workspace for Model
+    vctDynamicVector<double> mNetEffort, mAcceleration;
+};
+
+#endif // _osaSimulatedPlant_h
@@ -0,0 +1,127 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Lock-free recorder for control loop data
+  \ingroup sawControllers
+*/
+
+
+#ifndef _osaTelemetryRecorder_h
+#define _osaTelemetryRecorder_h
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <cisstOSAbstraction/osaThread.h>
+#include <sawControllers/osaRingBuffer.h>
+
+//! Always include last
+#include <sawControllers/sawControllersExport.h>
+
+/*!
+  Records fixed size records of doubles, one per control loop tick,
+  to a binary file.  The control loop is the single producer, it
+  reserves a record in a preallocated ring buffer, fills it and
+  commits it.  A writer thread is the single consumer, it drains the
+  ring buffer to the file.  The producer never blocks nor allocates,
+  records are dropped if the ring buffer is full.  Start and Stop
+  open and close the file and create and join the writer thread, call
+  them from another thread than the control loop, one at a time.  A
+  record reserved just before Stop may be written at the beginning of
+  the next file.
+
+  File format, little endian as written by the host:
+  - 8 bytes magic "SAWTLM1"
+  - uint64 number of doubles per record
+  - uint64 length of the column names, names separated by '\n'
+  - column names
+  - records
+
+  See the sawControllersTelemetryReader example to convert a file to
+  CSV.
+*/
+class CISST_EXPORT osaTelemetryRecorder
+{
+public:
+    osaTelemetryRecorder(void);
+    ~osaTelemetryRecorder();
+
+    /*! Allocate the ring buffer, must be called before Start and not
+      while recording.  The column names are written in the file
+      header, there must be one name per double in a record. */
+    void Configure(const std::vector<std::string> & columns,
+                   const size_t capacity);
+
+    //! Open the file and start the writer thread
+    bool Start(const std::string & filename);
+
+    //! Stop the writer thread once all committed records are written
+    void Stop(void);
+
+    inline bool IsRecording(void) const {
+        return osaRingBuffer::Load(mRecording) != 0;
+    }
+
+    /*! Pointer to the next record, 0 if the ring buffer is full or
+      not recording.  Producer only. */
+    inline double * Reserve(void) {
+        if (!IsRecording()) {
+            return 0;
+        }
+        double * record = mRing.Reserve();
+        if (!record) {
+            mDropped++;
+        }
+        return record;
+    }
+
+    //! Publish the record returned by Reserve.  Producer only.
+    inline void Commit(void) {
+        mRing.Commit();
+    }
+
+    inline size_t RecordSize(void) const {
+        return mRing.RecordSize();
+    }
+
+    //! Number of records dropped since Start
+    inline size_t Dropped(void) const {
+        return mDropped;
+    }
+
+protected:
+    void * Write(int);
+    //! Write all committed records, writer thread only
+    void Drain(void);
+
+    std::vector<std::string> mColumns;
+    osaRingBuffer mRing;
+
+    osaRingBuffer::IndexType mRecording;
+    osaRingBuffer::IndexType mStopRequested;
+    size_t mDropped;
+
+    FILE * mFile;
+    osaThread mThread;
+};
+
+#endif // _osaTelemetryRecorder_h
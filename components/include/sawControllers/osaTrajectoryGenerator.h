@@ -0,0 +1,149 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Online jerk limited trajectory generator in joint space
+  \ingroup sawControllers
+*/
+
+
+#ifndef _osaTrajectoryGenerator_h
+#define _osaTrajectoryGenerator_h
+
+#include <cisstVector/vctDynamicVector.h>
+#include <cisstVector/vctDynamicVectorRef.h>
+#include <cisstVector/vctDynamicConstVectorRef.h>
+
+//! Always include last
+#include <sawControllers/sawControllersExport.h>
+
+/*!
+  Computes jerk limited joint trajectories towards a goal, starting
+  from any position, velocity and acceleration so a new goal can be
+  set while moving.  Each joint follows a profile of up to seven
+  constant jerk segments: change of velocity to a cruise velocity,
+  cruise, then stop on the goal.  All joints are synchronized to
+  reach the goal at the same time by lowering the cruise velocity of
+  the joints that would arrive first.
+
+  Profiles are computed once per goal in SetGoal, using bisections
+  with a fixed maximum number of iterations.  Evaluate only finds the
+  current segment for each joint and integrates it, so its cost is
+  bounded and it doesn't allocate memory.  The profiles are time
+  optimal when starting with a null acceleration; otherwise the
+  acceleration is first brought to the cruise velocity using the
+  shortest jerk segments, which is close to but not always optimal.
+*/
+class CISST_EXPORT osaTrajectoryGenerator
+{
+public:
+    osaTrajectoryGenerator(void);
+    ~osaTrajectoryGenerator() {}
+
+    //! Set number of joints, limits have to be set for all joints
+    void SetSize(const size_t numberOfJoints);
+
+    inline size_t size(void) const {
+        return mNumberOfJoints;
+    }
+
+    //! Set limits for a joint, all limits must be positive
+    bool SetLimits(const size_t joint, const double velocity, const double acceleration, const double jerk);
+
+    //! True if limits have been set for all joints
+    bool HasLimits(void) const;
+
+    /*! Compute profiles from the current state to the goal, starting
+      at time now.  Returns false if limits are missing. */
+    bool SetGoal(const vctDynamicConstVectorRef<double> & goal,
+                 const vctDynamicConstVectorRef<double> & position,
+                 const vctDynamicConstVectorRef<double> & velocity,
+                 const vctDynamicConstVectorRef<double> & acceleration,
+                 const double now);
+
+    //! Abandon current trajectory
+    inline void Stop(void) {
+        mActive = false;
+    }
+
+    inline bool IsActive(void) const {
+        return mActive;
+    }
+
+    //! Duration of the current trajectory
+    inline double Duration(void) const {
+        return mDuration;
+    }
+
+    /*! State at a given time.  Returns true once the goal is reached,
+      the generator is then inactive. */
+    bool Evaluate(const double now,
+                  vctDynamicVectorRef<double> position,
+                  vctDynamicVectorRef<double> velocity,
+                  vctDynamicVectorRef<double> acceleration);
+
+protected:
+    enum {NUMBER_OF_SEGMENTS = 7,
+          MAX_ITERATIONS = 40};
+
+    //! Duration and jerk of each segment for one joint
+    typedef struct {
+        double Duration[NUMBER_OF_SEGMENTS];
+        double Jerk[NUMBER_OF_SEGMENTS];
+    } Profile;
+
+    //! Shortest segments from (v0, a0) to (v1, 0), fills 3 segments
+    static void VelocityChange(const double v0, const double a0, const double v1,
+                               const double aMax, const double jMax,
+                               double * duration, double * jerk);
+
+    //! Displacement for a profile without cruise, returns total duration
+    static double Displacement(const double v0, const double a0, const double vCruise,
+                               const double aMax, const double jMax,
+                               Profile & profile, double & displacement);
+
+    /*! Profile reaching goal with cruise velocity up to vLimit,
+      returns duration.  If cruiseOnly is set and the cruise velocity
+      can't be reached, returns 0 without computing the profile. */
+    static double ComputeProfile(const double distance, const double v0, const double a0,
+                                 const double vLimit, const double aMax, const double jMax,
+                                 Profile & profile, const bool cruiseOnly = false);
+
+    inline size_t Index(const size_t segment, const size_t joint) const {
+        return segment * mNumberOfJoints + joint;
+    }
+
+    size_t mNumberOfJoints;
+    vctDynamicVector<double> mVelocityLimit, mAccelerationLimit, mJerkLimit;
+
+    bool mActive;
+    double mStart;
+    double mDuration;
+    vctDynamicVector<double> mGoal;
+    //! Duration of each joint profile
+    vctDynamicVector<double> mJointDuration;
+
+    // one row of joints per segment: start time, jerk and state at
+    // the start of the segment
+    vctDynamicVector<double> mSegmentTime, mSegmentJerk;
+    vctDynamicVector<double> mSegmentPosition, mSegmentVelocity, mSegmentAcceleration;
+};
+
+#endif // _osaTrajectoryGenerator_h
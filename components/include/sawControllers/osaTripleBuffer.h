@@ -0,0 +1,120 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Lock-free triple buffer for parameter blocks
+  \ingroup sawControllers
+*/
+
+
+#ifndef _osaTripleBuffer_h
+#define _osaTripleBuffer_h
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*!
+  Publishes complete copies of a parameter block from a writer thread
+  to a reader thread (usually the control loop) without locks.  The
+  writer fills the back buffer and publishes it, the reader picks up
+  the latest published buffer with Update, typically once at the top
+  of each iteration, and then uses the front buffer.  The reader never
+  sees a buffer while it is written and never blocks nor allocates;
+  the writer never waits for the reader.  If the writer publishes
+  more than once between two Update, only the last one is used.
+
+  After Publish, the new back buffer holds an older block so the
+  writer has to rewrite it completely (e.g. copy from its own master
+  copy).  There must be a single writer at a time.
+*/
+template <class _type>
+class osaTripleBuffer
+{
+public:
+    osaTripleBuffer(void):
+        mBack(0),
+        mMiddle(1),
+        mFront(2)
+    {}
+
+    //! Set all buffers, not thread safe, use before starting the reader
+    void SetAll(const _type & value) {
+        for (size_t index = 0; index < 3; ++index) {
+            mBuffers[index] = value;
+        }
+    }
+
+    //! Buffer to fill, writer only
+    inline _type & Back(void) {
+        return mBuffers[mBack];
+    }
+
+    //! Make the back buffer available to the reader, writer only
+    inline void Publish(void) {
+        mBack = Exchange(mMiddle, mBack | FRESH) & INDEX;
+    }
+
+    /*! Use the last published buffer if any, reader only.  Returns
+      true if the front buffer changed. */
+    inline bool Update(void) {
+        if (!(Load(mMiddle) & FRESH)) {
+            return false;
+        }
+        mFront = Exchange(mMiddle, mFront) & INDEX;
+        return true;
+    }
+
+    //! Buffer in use, reader only
+    inline const _type & Front(void) const {
+        return mBuffers[mFront];
+    }
+
+protected:
+    enum {INDEX = 3, FRESH = 4};
+
+#if defined(_MSC_VER)
+    typedef long IndexType;
+    static inline IndexType Load(const IndexType & value) {
+        return _InterlockedOr(const_cast<volatile IndexType *>(&value), 0);
+    }
+    static inline IndexType Exchange(IndexType & destination, const IndexType value) {
+        return _InterlockedExchange(&destination, value);
+    }
+#else
+    typedef unsigned int IndexType;
+    static inline IndexType Load(const IndexType & value) {
+        return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+    }
+    static inline IndexType Exchange(IndexType & destination, const IndexType value) {
+        return __atomic_exchange_n(&destination, value, __ATOMIC_ACQ_REL);
+    }
+#endif
+
+    _type mBuffers[3];
+    //! Index of writer buffer
+    IndexType mBack;
+    //! Index of shared buffer and FRESH flag if not yet picked up
+    IndexType mMiddle;
+    //! Index of reader buffer
+    IndexType mFront;
+};
+
+#endif // _osaTripleBuffer_h
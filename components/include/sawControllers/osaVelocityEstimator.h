@@ -0,0 +1,146 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Joint velocity estimation from measured positions
+  \ingroup sawControllers
+*/
+
+
+#ifndef _osaVelocityEstimator_h
+#define _osaVelocityEstimator_h
+
+#include <vector>
+
+#include <cisstVector/vctDynamicVector.h>
+#include <cisstVector/vctDynamicVectorRef.h>
+#include <cisstVector/vctDynamicConstVectorRef.h>
+
+//! Always include last
+#include <sawControllers/sawControllersExport.h>
+
+/*!
+  Estimates joint velocities from timestamped positions.  The last
+  positions are kept in a ring buffer, one row of joints per sample,
+  so all the per-joint loops run over contiguous memory.  Each joint
+  uses one of the following filters:
+
+  - FINITE_DIFFERENCE: difference between the last two samples.
+  - LOW_PASS: finite difference followed by a first order low pass
+    filter, the cutoff frequency is in Hz.
+  - SAVITZKY_GOLAY: slope at the last sample of the least squares
+    polynomial fit of the last window samples.  Coefficients are
+    computed when the filter is set, samples are assumed to be
+    evenly spaced over the window.
+  - ADAPTIVE_WINDOW: end-fit first order adaptive window.  The
+    window is extended as long as all intermediate samples are within
+    the noise level of the line between the last sample and the
+    oldest one.  Uses small windows for fast motions and large ones
+    for slow motions.
+
+  Until enough samples are available, SAVITZKY_GOLAY and
+  ADAPTIVE_WINDOW fall back to finite differences.  Setters are meant
+  to be called at configuration time, they might allocate memory and
+  reset the history.  Estimate doesn't allocate memory.
+*/
+class CISST_EXPORT osaVelocityEstimator
+{
+public:
+    typedef enum {
+        FINITE_DIFFERENCE = 0,
+        LOW_PASS,
+        SAVITZKY_GOLAY,
+        ADAPTIVE_WINDOW
+    } FilterType;
+
+    osaVelocityEstimator(void);
+    ~osaVelocityEstimator() {}
+
+    //! Set number of joints, all joints use finite differences
+    void SetSize(const size_t numberOfJoints);
+
+    inline size_t size(void) const {
+        return mNumberOfJoints;
+    }
+
+    void SetFiniteDifference(const size_t joint);
+    void SetLowPass(const size_t joint, const double cutoffFrequency);
+    /*! Window is the number of samples, at least order + 1.  Order is
+      the order of the fitted polynomial, between 1 and MAX_ORDER. */
+    bool SetSavitzkyGolay(const size_t joint, const size_t window, const size_t order);
+    /*! Maximum number of samples in the window and noise level, in
+      the same units as the positions. */
+    bool SetAdaptiveWindow(const size_t joint, const size_t maxWindow, const double noiseLevel);
+
+    inline FilterType Filter(const size_t joint) const {
+        return static_cast<FilterType>(mFilter[joint]);
+    }
+
+    //! Clear history, e.g. when the previous positions can't be trusted
+    void Reset(void);
+
+    /*! Add a sample and compute velocities.  Returns false and sets
+      the velocities to zero if the timestamp didn't increase since the
+      last sample.  Sizes must match the number of joints. */
+    bool Estimate(const vctDynamicConstVectorRef<double> & position,
+                  const double timestamp,
+                  vctDynamicVectorRef<double> velocity);
+
+    enum {MAX_ORDER = 4};
+
+protected:
+    //! Resize the ring buffer for the largest window, resets history
+    void UpdateHistorySize(void);
+
+    //! Position of a given joint k samples ago
+    inline const double & Position(const size_t k, const size_t joint) const {
+        return mPositions[((mHead + mHistorySize - k) % mHistorySize) * mNumberOfJoints + joint];
+    }
+
+    inline const double & Timestamp(const size_t k) const {
+        return mTimestamps[(mHead + mHistorySize - k) % mHistorySize];
+    }
+
+    size_t mNumberOfJoints;
+    vctDynamicVector<int> mFilter;
+
+    // per joint parameters
+    vctDynamicVector<double> mTimeConstant;
+    vctDynamicVector<size_t> mWindow;
+    vctDynamicVector<double> mNoiseLevel;
+    //! Savitzky-Golay coefficients per joint, starting with last sample
+    std::vector<std::vector<double> > mJointCoefficients;
+    //! Savitzky-Golay coefficients, one row of joints per sample back in time
+    vctDynamicVector<double> mCoefficients;
+    size_t mMaxSavitzkyGolayWindow;
+
+    // history
+    size_t mHistorySize;
+    std::vector<double> mPositions;
+    std::vector<double> mTimestamps;
+    size_t mHead;
+    size_t mNumberOfSamples;
+
+    // filter outputs
+    vctDynamicVector<double> mLowPass;
+    vctDynamicVector<double> mSavitzkyGolay;
+};
+
+#endif // _osaVelocityEstimator_h
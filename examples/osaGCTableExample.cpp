@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include <cisstCommon/cmnPath.h>
+#include <cisstCommon/cmnRandomSequence.h>
+#include <sawControllers/osaGravityCompensationTable.h>
+
+// Build (or load) a gravity table for the WAM and report the
+// interpolation error against the exact model
+//   osaGCTableExample [samples per joint] [table file]
+// If the table file exists it is loaded, otherwise the table is built
+// and saved to the file.
+
+int main( int argc, char** argv ){
+
+  cmnLogger::SetMask( CMN_LOG_ALLOW_ALL );
+  cmnLogger::SetMaskFunction( CMN_LOG_ALLOW_ALL );
+  cmnLogger::SetMaskDefaultLog( CMN_LOG_ALLOW_ALL );
+
+  size_t nsamples = 37;
+  if( 1 < argc )
+    { nsamples = atoi( argv[1] ); }
+  std::string tablefile;
+  if( 2 < argc )
+    { tablefile = argv[2]; }
+
+  cmnPath path;
+  path.AddRelativeToCisstShare("/models/WAM");
+  std::string fname = path.Find("wam7.rob", cmnPath::READ);
+
+  // Rotate the base
+  vctMatrixRotation3<double> Rw0(  0.0,  0.0, -1.0,
+                                   0.0,  1.0,  0.0,
+                                   1.0,  0.0,  0.0 );
+  vctFixedSizeVector<double,3> tw0(0.0);
+  vctFrame4x4<double> Rtw0( Rw0, tw0 );
+
+  osaGravityCompensation GC( fname, Rtw0 );
+  osaGravityCompensationTable table( &GC );
+
+  // shoulder and elbow, other joints at nominal
+  std::vector<size_t> joints;
+  joints.push_back( 1 );
+  joints.push_back( 3 );
+  std::vector<double> lower( 2 ), upper( 2 );
+  lower[0] = -2.0;  upper[0] = 2.0;
+  lower[1] = -0.9;  upper[1] = 3.1;
+  std::vector<size_t> samples( 2, nsamples );
+  vctDynamicVector<double> qnominal( 7, 0.0 );
+  double tolerance = 0.05;
+
+  if( tablefile.empty() ||
+      table.Load( tablefile ) != osaGravityCompensationTable::ESUCCESS ){
+    if( table.Build( joints, lower, upper, samples, qnominal, tolerance ) !=
+	osaGravityCompensationTable::ESUCCESS ){
+      CMN_LOG_RUN_ERROR << "Failed to build gravity table" << std::endl;
+      return -1;
+    }
+    if( !tablefile.empty() )
+      { table.Save( tablefile ); }
+  }
+
+  std::cout << "cells using exact model: "
+	    << 100.0 * table.ExactCellsRatio() << "%" << std::endl;
+
+  // random configurations within the grid
+  cmnRandomSequence& random = cmnRandomSequence::GetInstance();
+  vctDynamicVector<double> q( qnominal );
+  vctDynamicVector<double> tau, exact;
+  double maxerror = 0.0;
+  size_t interpolated = 0;
+  const size_t n = 100000;
+  for( size_t k=0; k<n; k++ ){
+    for( size_t i=0; i<joints.size(); i++ )
+      { q[ joints[i] ] = random.ExtractRandomDouble( lower[i], upper[i] ); }
+    if( !table.IsInterpolated( q ) )
+      { continue; }
+    interpolated++;
+    table.Evaluate( q, tau );
+    GC.Evaluate( q, exact );
+    maxerror = std::max( maxerror, ( tau - exact ).MaxAbsElement() );
+  }
+
+  std::cout << "interpolated: " << interpolated << "/" << n << std::endl
+	    << "max interpolation error: " << maxerror << std::endl;
+
+  return 0;
+
+}
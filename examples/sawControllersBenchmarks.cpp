@@ -0,0 +1,1077 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*
+  Offline benchmarks for the controller kernels, driven by synthetic
+  sinusoidal trajectories:
+    sawControllersBenchmarks [iterations] [PID configuration file]
+
+  Results are printed on stdout, one JSON object per line:
+    {"benchmark": "osaPDGC-diagonal", "iterations": 100000,
+     "ns_per_call": 812.4, "allocations_per_call": 0,
+     "cache_misses_per_call": 0.02}
+  cache_misses_per_call is null if perf_event is not available.
+  Fixed size templates (osaPIDAntiWindupN, osaGravityCompensationN,
+  osaPDGCN) are run next to their dynamic versions for the same
+  number of joints.  The structure of arrays PID kernel is run for 7,
+  8, 28, 64 and 512 joints.  Models are loaded from the cisst share
+  directory (WAM and dVRK PSM, skipped if not found).  mtsPID is
+  always run with a generated 7 joints configuration, and also with
+  the PID configuration file if one is provided.  State table
+  benchmarks also print the memory used by the history and the
+  resident set size increase (rss_kb) for 16 tables.  Configuration
+  benchmarks write PID configuration files for 8, 64 and 256 joints in
+  the current directory and print the time to configure mtsPID from
+  XML and from the compiled file (ms_per_call).
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sstream>
+
+#include <cisstCommon/cmnPortability.h>
+#include <cisstCommon/cmnPath.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+
+#include <sawControllers/osaPIDAntiWindup.h>
+#include <sawControllers/osaPIDAntiWindupN.h>
+#include <sawControllers/osaPIDKernel.h>
+#include <sawControllers/osaVelocityEstimator.h>
+#include <sawControllers/osaDerivativeFilter.h>
+#include <sawControllers/osaGainSchedule.h>
+#include <sawControllers/osaSetpointInterpolator.h>
+#include <sawControllers/osaTrajectoryGenerator.h>
+#include <sawControllers/osaGravityCompensation.h>
+#include <sawControllers/osaGravityCompensationN.h>
+#include <sawControllers/osaGravityCompensationTable.h>
+#include <sawControllers/osaPDGC.h>
+#include <sawControllers/osaPDGCN.h>
+#include <sawControllers/osaCartesianImpedanceController.h>
+#include <sawControllers/osaPIDConfiguration.h>
+#include <sawControllers/mtsPID.h>
+#include <sawControllers/mtsStateTableFootprint.h>
+
+#if (CISST_OS == CISST_LINUX)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// count all heap allocations, the benchmarks are single threaded
+#include "../tests/sawControllersAllocations.h"
+
+// hardware cache misses for this thread, if available
+class CacheMissCounter
+{
+public:
+    CacheMissCounter(void):
+        mFileDescriptor(-1)
+    {
+#if (CISST_OS == CISST_LINUX)
+        struct perf_event_attr attributes;
+        memset(&attributes, 0, sizeof(attributes));
+        attributes.size = sizeof(attributes);
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        mFileDescriptor = syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+#endif
+    }
+
+    ~CacheMissCounter() {
+#if (CISST_OS == CISST_LINUX)
+        if (mFileDescriptor >= 0) {
+            close(mFileDescriptor);
+        }
+#endif
+    }
+
+    inline bool IsAvailable(void) const {
+        return (mFileDescriptor >= 0);
+    }
+
+    void Start(void) {
+#if (CISST_OS == CISST_LINUX)
+        if (IsAvailable()) {
+            ioctl(mFileDescriptor, PERF_EVENT_IOC_RESET, 0);
+            ioctl(mFileDescriptor, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    long long Stop(void) {
+        long long count = -1;
+#if (CISST_OS == CISST_LINUX)
+        if (IsAvailable()) {
+            ioctl(mFileDescriptor, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(mFileDescriptor, &count, sizeof(count)) != sizeof(count)) {
+                count = -1;
+            }
+        }
+#endif
+        return count;
+    }
+
+protected:
+    int mFileDescriptor;
+};
+
+// synthetic joint trajectory, precomputed so the benchmarks don't
+// measure sin/cos
+class Trajectory
+{
+public:
+    enum {NUMBER_OF_SAMPLES = 1000};
+
+    Trajectory(const size_t numberOfJoints, const double amplitude = 0.5):
+        mPositions(NUMBER_OF_SAMPLES)
+    {
+        for (size_t sample = 0; sample < NUMBER_OF_SAMPLES; ++sample) {
+            mPositions[sample].SetSize(numberOfJoints);
+            for (size_t joint = 0; joint < numberOfJoints; ++joint) {
+                mPositions[sample][joint] =
+                    amplitude * sin(2.0 * cmnPI * sample / NUMBER_OF_SAMPLES + joint);
+            }
+        }
+    }
+
+    inline const vctDynamicVector<double> & Position(const size_t iteration) const {
+        return mPositions[iteration % NUMBER_OF_SAMPLES];
+    }
+
+    // delayed position, used as measured position
+    inline const vctDynamicVector<double> & Measured(const size_t iteration) const {
+        return mPositions[(iteration + NUMBER_OF_SAMPLES - 3) % NUMBER_OF_SAMPLES];
+    }
+
+protected:
+    std::vector<vctDynamicVector<double> > mPositions;
+};
+
+template <class _benchmark>
+void Run(const std::string & name, _benchmark & benchmark, const size_t iterations)
+{
+    static CacheMissCounter cacheMisses;
+
+    // warm up, first calls are allowed to allocate
+    for (size_t i = 0; i < 100; ++i) {
+        benchmark(i);
+    }
+
+    const size_t allocationsStart = NumberOfAllocations;
+    cacheMisses.Start();
+    const double start = osaGetTime();
+    for (size_t i = 0; i < iterations; ++i) {
+        benchmark(i);
+    }
+    const double end = osaGetTime();
+    const long long misses = cacheMisses.Stop();
+    const size_t allocations = NumberOfAllocations - allocationsStart;
+
+    printf("{\"benchmark\": \"%s\", \"iterations\": %lu, \"ns_per_call\": %.1f, "
+           "\"allocations_per_call\": %g, \"cache_misses_per_call\": ",
+           name.c_str(), static_cast<unsigned long>(iterations),
+           (end - start) * 1.0e9 / iterations,
+           static_cast<double>(allocations) / iterations);
+    if (misses >= 0) {
+        printf("%g}\n", static_cast<double>(misses) / iterations);
+    } else {
+        printf("null}\n");
+    }
+    fflush(stdout);
+}
+
+class PIDAntiWindupBenchmark
+{
+public:
+    PIDAntiWindupBenchmark(const size_t numberOfJoints):
+        mTrajectory(numberOfJoints),
+        mPID(vctDynamicVector<double>(numberOfJoints, 100.0),
+             vctDynamicVector<double>(numberOfJoints, 1.0),
+             vctDynamicVector<double>(numberOfJoints, 5.0),
+             vctDynamicVector<double>(numberOfJoints, 0.1),
+             vctDynamicVector<double>(numberOfJoints, 10.0),
+             vctDynamicVector<double>(numberOfJoints, 0.0)),
+        mTau(numberOfJoints, 0.0)
+    {}
+
+    inline void operator()(const size_t i) {
+        mPID.Evaluate(vctDynamicConstVectorRef<double>(mTrajectory.Position(i)),
+                      vctDynamicConstVectorRef<double>(mTrajectory.Measured(i)),
+                      vctDynamicVectorRef<double>(mTau), 0.001);
+    }
+
+protected:
+    Trajectory mTrajectory;
+    osaPIDAntiWindup mPID;
+    vctDynamicVector<double> mTau;
+};
+
+// fixed size version, compare with PIDAntiWindupBenchmark for the same size
+template <vct::size_type _size>
+class PIDAntiWindupNBenchmark
+{
+public:
+    typedef osaPIDAntiWindupN<_size> ControllerType;
+    typedef typename ControllerType::VectorType VectorType;
+
+    PIDAntiWindupNBenchmark(void):
+        mPID(VectorType(100.0), VectorType(1.0), VectorType(5.0),
+             VectorType(0.1), VectorType(10.0)),
+        mTau(0.0)
+    {
+        Trajectory trajectory(_size);
+        for (size_t sample = 0; sample < Trajectory::NUMBER_OF_SAMPLES; ++sample) {
+            mPositions[sample].Assign(trajectory.Position(sample).Pointer());
+            mMeasured[sample].Assign(trajectory.Measured(sample).Pointer());
+        }
+    }
+
+    inline void operator()(const size_t i) {
+        const size_t sample = i % Trajectory::NUMBER_OF_SAMPLES;
+        mPID.Evaluate(mPositions[sample], mMeasured[sample], mTau, 0.001);
+    }
+
+protected:
+    ControllerType mPID;
+    VectorType mPositions[Trajectory::NUMBER_OF_SAMPLES];
+    VectorType mMeasured[Trajectory::NUMBER_OF_SAMPLES];
+    VectorType mTau;
+};
+
+template <vct::size_type _size>
+void RunPIDAntiWindup(const size_t iterations)
+{
+    std::stringstream size;
+    size << _size;
+    {
+        PIDAntiWindupBenchmark benchmark(_size);
+        Run("osaPIDAntiWindup-" + size.str(), benchmark, iterations);
+    }
+    {
+        PIDAntiWindupNBenchmark<_size> benchmark;
+        Run("osaPIDAntiWindupN-" + size.str(), benchmark, iterations);
+    }
+}
+
+class PIDKernelBenchmark
+{
+public:
+    PIDKernelBenchmark(const size_t numberOfJoints):
+        mTrajectory(numberOfJoints)
+    {
+        mKernel.SetSize(numberOfJoints);
+        mKernel.Field(osaPIDKernel::KP).SetAll(100.0);
+        mKernel.Field(osaPIDKernel::KI).SetAll(1.0);
+        mKernel.Field(osaPIDKernel::KD).SetAll(5.0);
+        mKernel.Field(osaPIDKernel::EFFORT_LOWER_LIMIT).SetAll(-10.0);
+        mKernel.Field(osaPIDKernel::EFFORT_UPPER_LIMIT).SetAll(10.0);
+        mKernel.Field(osaPIDKernel::APPLY_EFFORT_LIMIT).SetAll(1.0);
+        mKernel.Field(osaPIDKernel::TRACKING_ERROR_TOLERANCE).SetAll(10.0);
+        mKernel.Field(osaPIDKernel::ENABLED).SetAll(1.0);
+    }
+
+    inline void operator()(const size_t i) {
+        mKernel.Field(osaPIDKernel::COMMAND_POSITION).Assign(mTrajectory.Position(i));
+        mKernel.Field(osaPIDKernel::MEASURED_POSITION).Assign(mTrajectory.Measured(i));
+        bool newTrackingError;
+        mKernel.Evaluate(newTrackingError);
+    }
+
+protected:
+    Trajectory mTrajectory;
+    osaPIDKernel mKernel;
+};
+
+class GravityCompensationBenchmark
+{
+public:
+    GravityCompensationBenchmark(osaGravityCompensation & model,
+                                 const bool inverseDynamics):
+        mTrajectory(model.links.size()),
+        mModel(model),
+        mInverseDynamics(inverseDynamics),
+        mTau(model.links.size(), 0.0)
+    {}
+
+    inline void operator()(const size_t i) {
+        if (mInverseDynamics) {
+            mModel.EvaluateInverseDynamics(mTrajectory.Position(i), mTau);
+        } else {
+            mModel.Evaluate(mTrajectory.Position(i), mTau);
+        }
+    }
+
+protected:
+    Trajectory mTrajectory;
+    osaGravityCompensation & mModel;
+    bool mInverseDynamics;
+    vctDynamicVector<double> mTau;
+};
+
+// fixed size version, the WAM has 7 joints
+class GravityCompensationNBenchmark
+{
+public:
+    typedef osaGravityCompensationN<7> ModelType;
+
+    GravityCompensationNBenchmark(const std::string & robfile, const vctFrame4x4<double> & Rtw0):
+        mModel(robfile, Rtw0),
+        mTau(0.0)
+    {
+        Trajectory trajectory(7);
+        for (size_t sample = 0; sample < Trajectory::NUMBER_OF_SAMPLES; ++sample) {
+            mPositions[sample].Assign(trajectory.Position(sample).Pointer());
+        }
+    }
+
+    inline void operator()(const size_t i) {
+        mModel.Evaluate(mPositions[i % Trajectory::NUMBER_OF_SAMPLES], mTau);
+    }
+
+protected:
+    ModelType mModel;
+    ModelType::VectorType mPositions[Trajectory::NUMBER_OF_SAMPLES];
+    ModelType::VectorType mTau;
+};
+
+class GravityCompensationTableBenchmark
+{
+public:
+    GravityCompensationTableBenchmark(osaGravityCompensation & model):
+        mTable(&model),
+        mTau(model.links.size(), 0.0)
+    {
+        // shoulder and elbow, other joints at 0
+        std::vector<size_t> joints(2);
+        joints[0] = 1;
+        joints[1] = 3;
+        std::vector<double> lower(2, -1.0), upper(2, 1.0);
+        std::vector<size_t> samples(2, 37);
+        mTable.Build(joints, lower, upper, samples,
+                     vctDynamicVector<double>(model.links.size(), 0.0), 0.05);
+        // trajectory only on grid joints
+        Trajectory trajectory(model.links.size());
+        mPositions.resize(Trajectory::NUMBER_OF_SAMPLES);
+        for (size_t sample = 0; sample < mPositions.size(); ++sample) {
+            mPositions[sample].SetSize(model.links.size());
+            mPositions[sample].SetAll(0.0);
+            mPositions[sample][1] = trajectory.Position(sample)[1];
+            mPositions[sample][3] = trajectory.Position(sample)[3];
+        }
+    }
+
+    inline void operator()(const size_t i) {
+        mTable.Evaluate(mPositions[i % mPositions.size()], mTau);
+    }
+
+protected:
+    osaGravityCompensationTable mTable;
+    std::vector<vctDynamicVector<double> > mPositions;
+    vctDynamicVector<double> mTau;
+};
+
+class PDGCBenchmark
+{
+public:
+    PDGCBenchmark(const std::string & robfile, const vctFrame4x4<double> & Rtw0,
+                  const size_t numberOfJoints, const bool dense):
+        mTrajectory(numberOfJoints),
+        mPDGC(robfile, Rtw0,
+              Gains(numberOfJoints, 100.0, dense),
+              Gains(numberOfJoints, 5.0, dense),
+              vctDynamicVector<double>(numberOfJoints, 0.0)),
+        mTau(numberOfJoints, 0.0)
+    {}
+
+    static vctDynamicMatrix<double> Gains(const size_t size, const double gain, const bool dense) {
+        // small off diagonal terms to force the dense path
+        vctDynamicMatrix<double> K(size, size, dense ? 0.01 * gain : 0.0);
+        for (size_t i = 0; i < size; ++i) {
+            K.Element(i, i) = gain;
+        }
+        return K;
+    }
+
+    inline void operator()(const size_t i) {
+        mPDGC.Evaluate(mTrajectory.Position(i), mTrajectory.Measured(i), mTau, 0.001);
+    }
+
+protected:
+    Trajectory mTrajectory;
+    osaPDGC mPDGC;
+    vctDynamicVector<double> mTau;
+};
+
+// fixed size versions, the WAM has 7 joints
+class PDGCNBenchmark
+{
+public:
+    typedef osaPDGCN<7> ControllerType;
+
+    PDGCNBenchmark(const std::string & robfile, const vctFrame4x4<double> & Rtw0):
+        mPDGC(robfile, Rtw0, Gains(100.0), Gains(5.0))
+    {
+        Trajectory trajectory(7);
+        for (size_t sample = 0; sample < Trajectory::NUMBER_OF_SAMPLES; ++sample) {
+            mPositions[sample].Assign(trajectory.Position(sample).Pointer());
+            mMeasured[sample].Assign(trajectory.Measured(sample).Pointer());
+        }
+    }
+
+    static ControllerType::MatrixType Gains(const double gain) {
+        ControllerType::MatrixType K(0.0);
+        for (size_t i = 0; i < 7; ++i) {
+            K.Element(i, i) = gain;
+        }
+        return K;
+    }
+
+    inline void operator()(const size_t i) {
+        const size_t sample = i % Trajectory::NUMBER_OF_SAMPLES;
+        mPDGC.Evaluate(mPositions[sample], mMeasured[sample], mTau, 0.001);
+    }
+
+protected:
+    ControllerType mPDGC;
+    ControllerType::VectorType mPositions[Trajectory::NUMBER_OF_SAMPLES];
+    ControllerType::VectorType mMeasured[Trajectory::NUMBER_OF_SAMPLES];
+    ControllerType::VectorType mTau;
+};
+
+class CartesianImpedanceBenchmark
+{
+public:
+    CartesianImpedanceBenchmark(void):
+        mTrajectory(6, 0.05)
+    {
+        prmCartesianImpedanceGains gains;
+        gains.ForceOrientation().Identity();
+        gains.TorqueOrientation().Identity();
+        gains.ForcePosition().SetAll(0.0);
+        gains.PositionStiffnessPos().SetAll(-200.0);
+        gains.PositionStiffnessNeg().SetAll(-200.0);
+        gains.PositionDampingPos().SetAll(-5.0);
+        gains.PositionDampingNeg().SetAll(-5.0);
+        gains.ForceBiasPos().SetAll(0.0);
+        gains.ForceBiasNeg().SetAll(0.0);
+        gains.OrientationStiffnessPos().SetAll(-1.0);
+        gains.OrientationStiffnessNeg().SetAll(-1.0);
+        gains.OrientationDampingPos().SetAll(-0.1);
+        gains.OrientationDampingNeg().SetAll(-0.1);
+        gains.TorqueBiasPos().SetAll(0.0);
+        gains.TorqueBiasNeg().SetAll(0.0);
+        mController.SetGains(gains);
+        mWrench.Force().SetAll(0.0);
+    }
+
+    inline void operator()(const size_t i) {
+        const vctDynamicVector<double> & position = mTrajectory.Position(i);
+        mPose.Position().Translation().Assign(position[0], position[1], position[2]);
+        mPose.Position().Rotation().From(vctAxAnRot3(vct3(0.0, 0.0, 1.0), position[3]));
+        mTwist.VelocityLinear().Assign(position[4], position[5], 0.0);
+        mController.Update(mPose, mTwist, mWrench, true);
+    }
+
+protected:
+    Trajectory mTrajectory;
+    osaCartesianImpedanceController mController;
+    prmPositionCartesianGet mPose;
+    prmVelocityCartesianGet mTwist;
+    prmForceCartesianSet mWrench;
+};
+
+class VelocityEstimatorBenchmark
+{
+public:
+    VelocityEstimatorBenchmark(const size_t numberOfJoints,
+                               const osaVelocityEstimator::FilterType filter):
+        mTrajectory(numberOfJoints),
+        mVelocity(numberOfJoints, 0.0),
+        mTime(0.0)
+    {
+        mEstimator.SetSize(numberOfJoints);
+        for (size_t joint = 0; joint < numberOfJoints; ++joint) {
+            switch (filter) {
+            case osaVelocityEstimator::LOW_PASS:
+                mEstimator.SetLowPass(joint, 50.0);
+                break;
+            case osaVelocityEstimator::SAVITZKY_GOLAY:
+                mEstimator.SetSavitzkyGolay(joint, 9, 2);
+                break;
+            case osaVelocityEstimator::ADAPTIVE_WINDOW:
+                mEstimator.SetAdaptiveWindow(joint, 16, 1.0e-4);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    inline void operator()(const size_t i) {
+        // Run restarts at 0 after warm up, timestamps have to increase
+        mTime += 1.0 * cmn_ms;
+        mEstimator.Estimate(vctDynamicConstVectorRef<double>(mTrajectory.Measured(i)),
+                            mTime,
+                            vctDynamicVectorRef<double>(mVelocity));
+    }
+
+protected:
+    Trajectory mTrajectory;
+    osaVelocityEstimator mEstimator;
+    vctDynamicVector<double> mVelocity;
+    double mTime;
+};
+
+class DerivativeFilterBenchmark
+{
+public:
+    DerivativeFilterBenchmark(const size_t numberOfJoints):
+        mTrajectory(numberOfJoints),
+        mVelocity(numberOfJoints, 0.0),
+        mFiltered(numberOfJoints, 0.0)
+    {
+        // same cost for all filters, use a mix
+        mFilter.SetSize(numberOfJoints);
+        for (size_t joint = 0; joint < numberOfJoints; ++joint) {
+            switch (joint % 3) {
+            case 0:
+                mFilter.SetButterworth(joint, 50.0, 1.0 * cmn_ms);
+                break;
+            case 1:
+                mFilter.SetTustin(joint, 50.0, 1.0 * cmn_ms);
+                break;
+            default:
+                mFilter.SetObserver(joint, 100.0, 1.0e-4, 1.0 * cmn_ms);
+                break;
+            }
+        }
+    }
+
+    inline void operator()(const size_t i) {
+        mFilter.Evaluate(vctDynamicConstVectorRef<double>(mTrajectory.Measured(i)),
+                         vctDynamicConstVectorRef<double>(mVelocity),
+                         vctDynamicVectorRef<double>(mFiltered));
+    }
+
+protected:
+    Trajectory mTrajectory;
+    osaDerivativeFilter mFilter;
+    vctDynamicVector<double> mVelocity;
+    vctDynamicVector<double> mFiltered;
+};
+
+/*
+  Setpoints at 100Hz, reference evaluated at 1kHz so there is one
+  SetGoal for ten Evaluate.
+*/
+class SetpointInterpolatorBenchmark
+{
+public:
+    enum {DECIMATION = 10};
+
+    SetpointInterpolatorBenchmark(const size_t numberOfJoints,
+                                  const osaSetpointInterpolator::InterpolationType type):
+        mTrajectory(numberOfJoints),
+        mNoVelocity(0),
+        mPosition(numberOfJoints, 0.0),
+        mVelocity(numberOfJoints, 0.0),
+        mAcceleration(numberOfJoints, 0.0),
+        mTime(0.0)
+    {
+        mInterpolator.Configure(numberOfJoints, type, 1.0 * cmn_ms, 0.1);
+    }
+
+    inline void operator()(const size_t i) {
+        mTime += 1.0 * cmn_ms;
+        if ((i % DECIMATION) == 0) {
+            mInterpolator.SetGoal(vctDynamicConstVectorRef<double>(mTrajectory.Position(i)),
+                                  vctDynamicConstVectorRef<double>(mNoVelocity),
+                                  mTime, mTime);
+        }
+        mInterpolator.Evaluate(mTime,
+                               vctDynamicVectorRef<double>(mPosition),
+                               vctDynamicVectorRef<double>(mVelocity),
+                               vctDynamicVectorRef<double>(mAcceleration));
+    }
+
+protected:
+    Trajectory mTrajectory;
+    osaSetpointInterpolator mInterpolator;
+    vctDynamicVector<double> mNoVelocity;
+    vctDynamicVector<double> mPosition, mVelocity, mAcceleration;
+    double mTime;
+};
+
+/*
+  New goal every 100 iterations, set while moving, trajectory
+  evaluated at every iteration.
+*/
+class TrajectoryGeneratorBenchmark
+{
+public:
+    enum {DECIMATION = 100};
+
+    TrajectoryGeneratorBenchmark(const size_t numberOfJoints):
+        mTrajectory(numberOfJoints, 2.0),
+        mPosition(numberOfJoints, 0.0),
+        mVelocity(numberOfJoints, 0.0),
+        mAcceleration(numberOfJoints, 0.0),
+        mTime(0.0)
+    {
+        mGenerator.SetSize(numberOfJoints);
+        for (size_t joint = 0; joint < numberOfJoints; ++joint) {
+            mGenerator.SetLimits(joint, 1.0, 5.0, 50.0);
+        }
+    }
+
+    inline void operator()(const size_t i) {
+        mTime += 1.0 * cmn_ms;
+        if ((i % DECIMATION) == 0) {
+            mGenerator.SetGoal(vctDynamicConstVectorRef<double>(mTrajectory.Position(i * 37)),
+                               vctDynamicConstVectorRef<double>(mPosition),
+                               vctDynamicConstVectorRef<double>(mVelocity),
+                               vctDynamicConstVectorRef<double>(mAcceleration),
+                               mTime);
+        }
+        mGenerator.Evaluate(mTime,
+                            vctDynamicVectorRef<double>(mPosition),
+                            vctDynamicVectorRef<double>(mVelocity),
+                            vctDynamicVectorRef<double>(mAcceleration));
+    }
+
+protected:
+    Trajectory mTrajectory;
+    osaTrajectoryGenerator mGenerator;
+    vctDynamicVector<double> mPosition, mVelocity, mAcceleration;
+    double mTime;
+};
+
+/*
+  Gains scheduled on measured position, 16 points per joint.
+*/
+class GainScheduleBenchmark
+{
+public:
+    enum {NUMBER_OF_POINTS = 16};
+
+    GainScheduleBenchmark(const size_t numberOfJoints):
+        mTrajectory(numberOfJoints),
+        mUser(numberOfJoints, 0.0),
+        mKp(numberOfJoints, 0.0),
+        mKi(numberOfJoints, 0.0),
+        mKd(numberOfJoints, 0.0)
+    {
+        osaGainSchedule::Table table;
+        table.SetSize(numberOfJoints);
+        std::vector<double> values(NUMBER_OF_POINTS), kp(NUMBER_OF_POINTS), ki(NUMBER_OF_POINTS), kd(NUMBER_OF_POINTS);
+        for (size_t point = 0; point < NUMBER_OF_POINTS; ++point) {
+            values[point] = -0.5 + static_cast<double>(point) / (NUMBER_OF_POINTS - 1);
+            kp[point] = 100.0 + 10.0 * point;
+            ki[point] = 1.0;
+            kd[point] = 5.0 + point;
+        }
+        for (size_t joint = 0; joint < numberOfJoints; ++joint) {
+            table.SetJoint(joint, osaGainSchedule::POSITION, values, kp, ki, kd);
+        }
+        mSchedule.SetSize(numberOfJoints);
+        mSchedule.SetTable(table);
+        mSchedule.Update();
+    }
+
+    inline void operator()(const size_t i) {
+        mSchedule.Evaluate(vctDynamicConstVectorRef<double>(mTrajectory.Measured(i)),
+                           vctDynamicConstVectorRef<double>(mUser),
+                           vctDynamicVectorRef<double>(mKp),
+                           vctDynamicVectorRef<double>(mKi),
+                           vctDynamicVectorRef<double>(mKd));
+    }
+
+protected:
+    Trajectory mTrajectory;
+    osaGainSchedule mSchedule;
+    vctDynamicVector<double> mUser, mKp, mKi, mKd;
+};
+
+/*
+  Cost of Advance for a state table holding the measured and
+  commanded joint states, with the joint names in every slot (as
+  mtsPID used to do) or without.  The table is filled once in the
+  constructor so all slots are allocated.
+*/
+class StateTableBenchmark
+{
+public:
+    StateTableBenchmark(const size_t numberOfJoints, const size_t depth, const bool withNames):
+        mTrajectory(numberOfJoints),
+        mTable(depth, "Benchmark")
+    {
+        mMeasure.Position().SetSize(numberOfJoints, 0.0);
+        mMeasure.Velocity().SetSize(numberOfJoints, 0.0);
+        mMeasure.Effort().SetSize(numberOfJoints, 0.0);
+        mCommand.Position().SetSize(numberOfJoints, 0.0);
+        mCommand.Effort().SetSize(numberOfJoints, 0.0);
+        if (withNames) {
+            mMeasure.Name().resize(numberOfJoints);
+            for (size_t i = 0; i < numberOfJoints; ++i) {
+                std::stringstream name;
+                name << "outer_joint_number_" << i;
+                mMeasure.Name().at(i) = name.str();
+            }
+            mCommand.Name() = mMeasure.Name();
+        }
+        mFootprint.AddData(mTable, mMeasure, "StateJointMeasure");
+        mFootprint.AddData(mTable, mCommand, "StateJointCommand");
+        for (size_t i = 0; i < depth; ++i) {
+            (*this)(i);
+        }
+    }
+
+    inline void operator()(const size_t i) {
+        mTable.Start();
+        mMeasure.Position().Assign(mTrajectory.Measured(i));
+        mCommand.Position().Assign(mTrajectory.Position(i));
+        mTable.Advance();
+    }
+
+    inline size_t Bytes(void) const {
+        return mFootprint.Bytes();
+    }
+
+protected:
+    Trajectory mTrajectory;
+    mtsStateTable mTable;
+    prmStateJoint mMeasure, mCommand;
+    mtsStateTableFootprint mFootprint;
+};
+
+//! Resident set size in kB, -1 if not available
+long ResidentSetSize(void)
+{
+#if (CISST_OS == CISST_LINUX)
+    FILE * file = fopen("/proc/self/statm", "r");
+    if (!file) {
+        return -1;
+    }
+    long pages, resident;
+    const int read = fscanf(file, "%ld %ld", &pages, &resident);
+    fclose(file);
+    if (read != 2) {
+        return -1;
+    }
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#else
+    return -1;
+#endif
+}
+
+void RunStateTables(const std::string & name, const size_t numberOfJoints,
+                    const bool withNames, const size_t iterations)
+{
+    // one table per arm, 16 arms with the default mtsTask depth
+    const size_t numberOfArms = 16;
+    const size_t depth = 256;
+    const long rssStart = ResidentSetSize();
+    std::vector<StateTableBenchmark *> tables;
+    for (size_t arm = 0; arm < numberOfArms; ++arm) {
+        tables.push_back(new StateTableBenchmark(numberOfJoints, depth, withNames));
+    }
+    const long rssEnd = ResidentSetSize();
+    printf("{\"benchmark\": \"%s\", \"tables\": %lu, \"bytes_per_table\": %lu, \"rss_kb\": %ld}\n",
+           name.c_str(), static_cast<unsigned long>(numberOfArms),
+           static_cast<unsigned long>(tables[0]->Bytes()),
+           ((rssStart >= 0) && (rssEnd >= 0)) ? (rssEnd - rssStart) : -1);
+    Run(name, *(tables[0]), iterations);
+    for (size_t arm = 0; arm < numberOfArms; ++arm) {
+        delete tables[arm];
+    }
+}
+
+class PIDComponentBenchmark
+{
+public:
+    PIDComponentBenchmark(const std::string & filename):
+        mPID("PID", 1.0 * cmn_ms)
+    {
+        mPID.Configure(filename);
+        mPID.SetSimulated();
+        mPID.Startup();
+    }
+
+    inline void operator()(const size_t) {
+        mPID.Run();
+    }
+
+    inline size_t MemoryFootprint(void) const {
+        return mPID.MemoryFootprint();
+    }
+
+protected:
+    mtsPID mPID;
+};
+
+// PID configuration file with all per joint elements
+std::string WriteConfiguration(const size_t numberOfJoints)
+{
+    std::stringstream filename;
+    filename << "sawControllersBenchmarks-PID-" << numberOfJoints << ".xml";
+    FILE * file = fopen(filename.str().c_str(), "w");
+    if (!file) {
+        return "";
+    }
+    fprintf(file, "<?xml version=\"1.0\" encoding=\"utf-8\" ?>\n"
+            "<controller type=\"PID\" interface=\"JointTorqueInterface\" numofjoints=\"%lu\">\n"
+            "  <interpolation Type=\"Linear\" MaxInterval=\"0.1\"/>\n"
+            "  <joints>\n", static_cast<unsigned long>(numberOfJoints));
+    for (size_t joint = 0; joint < numberOfJoints; ++joint) {
+        fprintf(file,
+                "    <joint index=\"%lu\" name=\"joint%lu\" type=\"Revolute\">\n"
+                "      <pid PGain=\"100.0\" DGain=\"5.0\" IGain=\"1.0\" OffsetTorque=\"0.0\" Forget=\"1.0\" Nonlinear=\"0.0\" VelocityFeedForward=\"0.5\"/>\n"
+                "      <limit MinILimit=\"-1\" MaxILimit=\"1\" ErrorLimit=\"0.5\" Deadband=\"0.0\"/>\n"
+                "      <velocity Filter=\"SavitzkyGolay\" Window=\"7\" Order=\"2\"/>\n"
+                "      <derivative Filter=\"Butterworth\" Cutoff=\"100.0\"/>\n"
+                "      <trajectory MaxVelocity=\"1.0\" MaxAcceleration=\"5.0\" MaxJerk=\"50.0\"/>\n"
+                "      <pos Units=\"deg\" LowerLimit=\"-170\" UpperLimit=\"170\"/>\n"
+                "    </joint>\n",
+                static_cast<unsigned long>(joint), static_cast<unsigned long>(joint));
+    }
+    fprintf(file, "  </joints>\n</controller>\n");
+    fclose(file);
+    return filename.str();
+}
+
+// time to create and configure a PID component, first run with the
+// cache creates the compiled file
+void RunConfiguration(const std::string & name, const size_t numberOfJoints, const bool useCache)
+{
+    const std::string filename = WriteConfiguration(numberOfJoints);
+    if (filename.empty()) {
+        fprintf(stderr, "can't write PID configuration file, skipping %s\n", name.c_str());
+        return;
+    }
+    const std::string compiled = filename + ".compiled";
+    std::remove(compiled.c_str());
+    const size_t runs = 10;
+    double total = 0.0;
+    for (size_t run = 0; run <= runs; ++run) {
+        const double start = osaGetTime();
+        {
+            mtsPID pid(name, 1.0 * cmn_ms);
+            if (useCache) {
+                pid.SetConfigurationCache(".");
+            }
+            pid.Configure(filename);
+        }
+        // first run is warm up
+        if (run > 0) {
+            total += osaGetTime() - start;
+        }
+    }
+    printf("{\"benchmark\": \"%s\", \"joints\": %lu, \"runs\": %lu, \"ms_per_call\": %.3f}\n",
+           name.c_str(), static_cast<unsigned long>(numberOfJoints),
+           static_cast<unsigned long>(runs), total * 1.0e3 / runs);
+    fflush(stdout);
+    std::remove(compiled.c_str());
+    std::remove(filename.c_str());
+}
+
+int main(int argc, char ** argv)
+{
+    cmnLogger::SetMask(CMN_LOG_ALLOW_ERRORS);
+    cmnLogger::SetMaskFunction(CMN_LOG_ALLOW_ERRORS);
+    cmnLogger::SetMaskDefaultLog(CMN_LOG_ALLOW_ERRORS);
+
+    size_t iterations = 100000;
+    if (argc > 1) {
+        iterations = atoi(argv[1]);
+    }
+    std::string pidFile;
+    if (argc > 2) {
+        pidFile = argv[2];
+    }
+
+    // dynamic and fixed size versions for common sizes
+    RunPIDAntiWindup<3>(iterations);
+    RunPIDAntiWindup<6>(iterations);
+    RunPIDAntiWindup<7>(iterations);
+    RunPIDAntiWindup<8>(iterations);
+    {
+        // single arm, four arms (mtsPIDMulti) and larger batches
+        const size_t sizes[5] = {7, 8, 28, 64, 512};
+        for (size_t index = 0; index < 5; ++index) {
+            std::stringstream name;
+            name << "osaPIDKernel-" << sizes[index];
+            PIDKernelBenchmark benchmark(sizes[index]);
+            Run(name.str(), benchmark, iterations);
+        }
+    }
+    {
+        CartesianImpedanceBenchmark benchmark;
+        Run("osaCartesianImpedanceController", benchmark, iterations);
+    }
+
+    {
+        VelocityEstimatorBenchmark benchmark(7, osaVelocityEstimator::FINITE_DIFFERENCE);
+        Run("osaVelocityEstimator-FiniteDifference-7", benchmark, iterations);
+    }
+    {
+        VelocityEstimatorBenchmark benchmark(7, osaVelocityEstimator::LOW_PASS);
+        Run("osaVelocityEstimator-LowPass-7", benchmark, iterations);
+    }
+    {
+        VelocityEstimatorBenchmark benchmark(7, osaVelocityEstimator::SAVITZKY_GOLAY);
+        Run("osaVelocityEstimator-SavitzkyGolay-7", benchmark, iterations);
+    }
+    {
+        VelocityEstimatorBenchmark benchmark(7, osaVelocityEstimator::ADAPTIVE_WINDOW);
+        Run("osaVelocityEstimator-AdaptiveWindow-7", benchmark, iterations);
+    }
+
+    {
+        DerivativeFilterBenchmark benchmark(7);
+        Run("osaDerivativeFilter-7", benchmark, iterations);
+    }
+
+    {
+        GainScheduleBenchmark benchmark(7);
+        Run("osaGainSchedule-7", benchmark, iterations);
+    }
+
+    {
+        SetpointInterpolatorBenchmark benchmark(7, osaSetpointInterpolator::LINEAR);
+        Run("osaSetpointInterpolator-Linear-7", benchmark, iterations);
+    }
+
+    {
+        SetpointInterpolatorBenchmark benchmark(7, osaSetpointInterpolator::QUINTIC);
+        Run("osaSetpointInterpolator-Quintic-7", benchmark, iterations);
+    }
+
+    {
+        TrajectoryGeneratorBenchmark benchmark(7);
+        Run("osaTrajectoryGenerator-7", benchmark, iterations);
+    }
+
+    RunStateTables("mtsStateTable-prmStateJoint-names-7", 7, true, iterations);
+    RunStateTables("mtsStateTable-prmStateJoint-7", 7, false, iterations);
+
+    {
+        const size_t sizes[3] = {8, 64, 256};
+        for (size_t index = 0; index < 3; ++index) {
+            std::stringstream name;
+            name << "mtsPID-Configure-" << sizes[index];
+            RunConfiguration(name.str() + "-XML", sizes[index], false);
+            RunConfiguration(name.str() + "-compiled", sizes[index], true);
+        }
+    }
+
+    cmnPath path;
+    path.AddRelativeToCisstShare("/models/WAM");
+    const std::string robfile = path.Find("wam7.rob", cmnPath::READ);
+    if (robfile.empty()) {
+        fprintf(stderr, "can't find wam7.rob, skipping model based benchmarks\n");
+    } else {
+        vctMatrixRotation3<double> Rw0(0.0, 0.0, -1.0,
+                                       0.0, 1.0,  0.0,
+                                       1.0, 0.0,  0.0);
+        vctFrame4x4<double> Rtw0(Rw0, vctFixedSizeVector<double, 3>(0.0));
+
+        osaGravityCompensation model(robfile, Rtw0);
+        {
+            GravityCompensationBenchmark benchmark(model, false);
+            Run(model.UsesGravityOnly()
+                ? "osaGravityCompensation-RNE"
+                : "osaGravityCompensation-fallback", benchmark, iterations);
+        }
+        {
+            GravityCompensationBenchmark benchmark(model, true);
+            Run("osaGravityCompensation-InverseDynamics", benchmark, iterations);
+        }
+        {
+            GravityCompensationNBenchmark benchmark(robfile, Rtw0);
+            Run("osaGravityCompensationN-7", benchmark, iterations);
+        }
+        {
+            GravityCompensationTableBenchmark benchmark(model);
+            Run("osaGravityCompensationTable", benchmark, iterations);
+        }
+        {
+            PDGCBenchmark benchmark(robfile, Rtw0, 7, true);
+            Run("osaPDGC-dense", benchmark, iterations);
+        }
+        {
+            PDGCBenchmark benchmark(robfile, Rtw0, 7, false);
+            Run("osaPDGC-diagonal", benchmark, iterations);
+        }
+        {
+            PDGCNBenchmark benchmark(robfile, Rtw0);
+            Run("osaPDGCN-7", benchmark, iterations);
+        }
+    }
+
+    // dVRK PSM, gravity only RNE against full inverse dynamics
+    cmnPath dVRKPath;
+    dVRKPath.AddRelativeToCisstShare("/models/dVRK");
+    dVRKPath.AddRelativeToCisstShare("/sawIntuitiveResearchKit/kinematic");
+    const std::string psmfile = dVRKPath.Find("dvpsm.rob", cmnPath::READ);
+    if (psmfile.empty()) {
+        fprintf(stderr, "can't find dvpsm.rob, skipping dVRK benchmarks\n");
+    } else {
+        vctFrame4x4<double> Rtw0;
+        osaGravityCompensation model(psmfile, Rtw0);
+        {
+            GravityCompensationBenchmark benchmark(model, false);
+            Run(model.UsesGravityOnly()
+                ? "osaGravityCompensation-RNE-dVRK-PSM"
+                : "osaGravityCompensation-fallback-dVRK-PSM", benchmark, iterations);
+        }
+        {
+            GravityCompensationBenchmark benchmark(model, true);
+            Run("osaGravityCompensation-InverseDynamics-dVRK-PSM", benchmark, iterations);
+        }
+    }
+
+    // generated configuration so results are comparable between runs
+    const std::string generatedPIDFile = WriteConfiguration(7);
+    if (generatedPIDFile.empty()) {
+        fprintf(stderr, "can't write PID configuration file, skipping mtsPID-simulated-7\n");
+    } else {
+        {
+            PIDComponentBenchmark benchmark(generatedPIDFile);
+            Run("mtsPID-simulated-7", benchmark, iterations);
+            printf("{\"benchmark\": \"mtsPID-state-tables-7\", \"bytes\": %lu}\n",
+                   static_cast<unsigned long>(benchmark.MemoryFootprint()));
+        }
+        std::remove(generatedPIDFile.c_str());
+    }
+
+    if (!pidFile.empty()) {
+        PIDComponentBenchmark benchmark(pidFile);
+        Run("mtsPID-simulated", benchmark, iterations);
+        printf("{\"benchmark\": \"mtsPID-state-tables\", \"bytes\": %lu}\n",
+               static_cast<unsigned long>(benchmark.MemoryFootprint()));
+    }
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*
+  Replay a recorded teleoperation session with mtsTeleOperation in
+  lockstep, as fast as possible (see mtsLockstep and mtsScriptedIO for
+  the file formats):
+    sawControllersReplay master.txt slave.txt clutch.txt operator.txt duration [output.txt]
+
+  If an output file is provided, the slave goal is written after each
+  iteration (time, translation and row major rotation) so two replays
+  can be compared.  The result is printed on stdout as JSON:
+    {"replay": "teleoperation", "virtual_s": 3600, "wall_s": 12.1,
+     "realtime_factor": 297.5, "runs": 3600000}
+  Each replay is single threaded, run several processes to use more
+  cores.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstMultiTask/mtsManagerLocal.h>
+#include <cisstMultiTask/mtsInterfaceRequired.h>
+
+#include <sawControllers/mtsTeleOperation.h>
+#include <sawControllers/mtsScriptedIO.h>
+#include <sawControllers/mtsLockstep.h>
+
+int main(int argc, char ** argv)
+{
+    if ((argc != 6) && (argc != 7)) {
+        fprintf(stderr, "usage: %s <master> <slave> <clutch> <operator present> <duration> [output]\n", argv[0]);
+        return -1;
+    }
+    const double duration = atof(argv[5]);
+
+    mtsManagerLocal * manager = mtsManagerLocal::GetInstance();
+
+    mtsScriptedIO * io = new mtsScriptedIO("io");
+    if (!io->AddCartesianInterface("Master", argv[1])
+        || !io->AddCartesianInterface("Slave", argv[2])
+        || !io->AddButtonInterface("Clutch", argv[3])
+        || !io->AddButtonInterface("OperatorPresent", argv[4])) {
+        fprintf(stderr, "failed to load scripts\n");
+        return -1;
+    }
+
+    mtsTeleOperation * teleop = new mtsTeleOperation("teleop", 1.0 * cmn_ms);
+
+    // client to enable the teleoperation and read the slave goal
+    mtsComponent * client = new mtsComponent("client");
+    mtsFunctionWrite enable;
+    mtsFunctionRead getSlaveGoal;
+    client->AddInterfaceRequired("Setting")->AddFunction("Enable", enable);
+    client->AddInterfaceRequired("Slave")->AddFunction("GetPositionCartesianDesired", getSlaveGoal);
+
+    manager->AddComponent(io);
+    manager->AddComponent(teleop);
+    manager->AddComponent(client);
+    if (!manager->Connect("teleop", "Master", "io", "Master")
+        || !manager->Connect("teleop", "Slave", "io", "Slave")
+        || !manager->Connect("teleop", "Clutch", "io", "Clutch")
+        || !manager->Connect("teleop", "OperatorPresent", "io", "OperatorPresent")
+        || !manager->Connect("client", "Setting", "teleop", "Setting")
+        || !manager->Connect("client", "Slave", "io", "Slave")) {
+        fprintf(stderr, "failed to connect components\n");
+        return -1;
+    }
+
+    FILE * output = 0;
+    if (argc == 7) {
+        output = fopen(argv[6], "w");
+        if (!output) {
+            fprintf(stderr, "can't open %s\n", argv[6]);
+            return -1;
+        }
+    }
+
+    // components are never created nor started, the harness runs them
+    mtsLockstep lockstep;
+    lockstep.AddScript(io);
+    lockstep.AddTask(teleop);
+    lockstep.Startup();
+    enable(true);
+
+    prmPositionCartesianSet goal;
+    const double start = osaGetTime();
+    while (lockstep.Time() < duration) {
+        lockstep.Step();
+        if (output) {
+            getSlaveGoal(goal);
+            const vctFrm4x4 frame(goal.Goal());
+            fprintf(output, "%.9f", lockstep.Time());
+            for (size_t row = 0; row < 3; ++row) {
+                fprintf(output, " %.9g", frame.Translation().at(row));
+            }
+            for (size_t row = 0; row < 3; ++row) {
+                for (size_t column = 0; column < 3; ++column) {
+                    fprintf(output, " %.9g", frame.Element(row, column));
+                }
+            }
+            fputc('\n', output);
+        }
+    }
+    const double elapsed = osaGetTime() - start;
+    lockstep.Cleanup();
+
+    if (output) {
+        fclose(output);
+    }
+
+    printf("{\"replay\": \"teleoperation\", \"virtual_s\": %g, \"wall_s\": %g, \"realtime_factor\": %g, \"runs\": %lu}\n",
+           lockstep.Time(), elapsed, (elapsed > 0.0) ? (lockstep.Time() / elapsed) : 0.0,
+           static_cast<unsigned long>(lockstep.NumberOfRuns()));
+    return 0;
+}
@@ -0,0 +1,90 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*
+  Convert a telemetry file recorded by osaTelemetryRecorder (see
+  mtsPID command StartTelemetry) to CSV:
+    sawControllersTelemetryReader file.tlm > file.csv
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+int main(int argc, char ** argv)
+{
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <telemetry file>\n", argv[0]);
+        return -1;
+    }
+
+    FILE * file = fopen(argv[1], "rb");
+    if (!file) {
+        fprintf(stderr, "can't open %s\n", argv[1]);
+        return -1;
+    }
+
+    char magic[8];
+    unsigned long long recordSize, namesLength;
+    if ((fread(magic, 1, sizeof(magic), file) != sizeof(magic))
+        || (strncmp(magic, "SAWTLM1", sizeof(magic)) != 0)
+        || (fread(&recordSize, sizeof(recordSize), 1, file) != 1)
+        || (fread(&namesLength, sizeof(namesLength), 1, file) != 1)
+        || (recordSize == 0)) {
+        fprintf(stderr, "%s is not a telemetry file\n", argv[1]);
+        fclose(file);
+        return -1;
+    }
+
+    // header, names are separated by new lines
+    std::string names(namesLength, '\0');
+    if (fread(&(names[0]), 1, namesLength, file) != namesLength) {
+        fprintf(stderr, "%s: truncated header\n", argv[1]);
+        fclose(file);
+        return -1;
+    }
+    size_t column = 0;
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == '\n') {
+            column++;
+            if (column < recordSize) {
+                fputc(',', stdout);
+            }
+        } else {
+            fputc(names[i], stdout);
+        }
+    }
+    fputc('\n', stdout);
+
+    // records, a truncated last record is ignored
+    std::vector<double> record(recordSize);
+    size_t numberOfRecords = 0;
+    while (fread(&(record[0]), sizeof(double), recordSize, file) == recordSize) {
+        for (size_t i = 0; i < recordSize; ++i) {
+            printf(i == 0 ? "%.9f" : ",%.9g", record[i]);
+        }
+        fputc('\n', stdout);
+        numberOfRecords++;
+    }
+    fclose(file);
+
+    fprintf(stderr, "%lu records of %llu values\n",
+            static_cast<unsigned long>(numberOfRecords), recordSize);
+    return 0;
+}
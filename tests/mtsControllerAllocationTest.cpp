@@ -0,0 +1,144 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*
+  mtsGravityCompensation::Run and mtsPDGC::Run must not allocate once
+  started.  The controllers are enabled and stepped with mtsLockstep,
+  connected to a stub robot.  Returns 77 (skipped) if wam7.rob can't
+  be found.
+*/
+
+#include <cmath>
+
+#include <cisstCommon/cmnPath.h>
+#include <cisstMultiTask/mtsManagerLocal.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+#include <cisstMultiTask/mtsInterfaceRequired.h>
+#include <cisstParameterTypes/prmPositionJointGet.h>
+#include <cisstParameterTypes/prmForceTorqueJointSet.h>
+
+#include <sawControllers/mtsGravityCompensation.h>
+#include <sawControllers/mtsPDGC.h>
+#include <sawControllers/mtsLockstep.h>
+
+#include "sawControllersAllocations.h"
+
+// provides the joint positions and keeps the last torques
+class RobotStub: public mtsComponent
+{
+public:
+    RobotStub(const std::string & name, const size_t numberOfJoints):
+        mtsComponent(name)
+    {
+        Position.SetSize(numberOfJoints);
+        Position.Position().SetAll(0.0);
+        Position.SetValid(true);
+        Torque.SetSize(numberOfJoints);
+        mtsInterfaceProvided * robot = AddInterfaceProvided("Robot");
+        robot->AddCommandRead(&RobotStub::GetPositionJoint, this, "GetPositionJoint", Position);
+        robot->AddCommandWrite(&RobotStub::SetTorqueJoint, this, "SetTorqueJoint");
+    }
+
+    void GetPositionJoint(prmPositionJointGet & position) const {
+        position = Position;
+    }
+
+    void SetTorqueJoint(const prmForceTorqueJointSet & torque) {
+        Torque.ForceTorque().Assign(torque.ForceTorque());
+    }
+
+    prmPositionJointGet Position;
+    prmForceTorqueJointSet Torque;
+};
+
+static bool TestController(mtsController * controller, const bool feedback)
+{
+    const size_t numberOfJoints = 7;
+    const size_t iterations = 5000;
+    const std::string name = controller->GetName();
+
+    mtsManagerLocal * manager = mtsManagerLocal::GetInstance();
+    RobotStub * robot = new RobotStub(name + "-robot", numberOfJoints);
+    mtsComponent * client = new mtsComponent(name + "-client");
+    mtsFunctionWrite enable;
+    client->AddInterfaceRequired("Control")->AddFunction("Enable", enable);
+
+    manager->AddComponent(controller);
+    manager->AddComponent(robot);
+    manager->AddComponent(client);
+    if (!manager->Connect(name, "Input", robot->GetName(), "Robot")
+        || !manager->Connect(name, "Output", robot->GetName(), "Robot")
+        || (feedback && !manager->Connect(name, "Feedback", robot->GetName(), "Robot"))
+        || !manager->Connect(client->GetName(), "Control", name, "Control")) {
+        fprintf(stderr, "%s: failed to connect components\n", name.c_str());
+        return false;
+    }
+
+    mtsLockstep lockstep;
+    lockstep.AddTask(controller);
+    lockstep.Startup();
+    enable(mtsBool(true));
+
+    size_t start = 0;
+    for (size_t i = 0; i < (iterations + 100); ++i) {
+        if (i == 100) {
+            start = NumberOfAllocations;
+        }
+        for (size_t joint = 0; joint < numberOfJoints; ++joint) {
+            robot->Position.Position().at(joint) = 0.5 * sin(0.001 * i + joint);
+        }
+        lockstep.Step();
+    }
+    const bool passed = CheckNoAllocation(name.c_str(), start, iterations);
+    lockstep.Cleanup();
+
+    if (robot->Torque.ForceTorque().MaxAbsElement() == 0.0) {
+        fprintf(stderr, "%s: no torque sent, controller not enabled\n", name.c_str());
+        return false;
+    }
+    return passed;
+}
+
+int main(void)
+{
+    cmnPath path;
+    path.AddRelativeToCisstShare("/models/WAM");
+    const std::string robfile = path.Find("wam7.rob", cmnPath::READ);
+    if (robfile.empty()) {
+        fprintf(stderr, "can't find wam7.rob, skipping\n");
+        return 77;
+    }
+    vctMatrixRotation3<double> Rw0(0.0, 0.0, -1.0,
+                                   0.0, 1.0,  0.0,
+                                   1.0, 0.0,  0.0);
+    vctFrame4x4<double> Rtw0(Rw0, vctFixedSizeVector<double, 3>(0.0));
+
+    bool passed = true;
+    passed &= TestController(new mtsGravityCompensation("GravityCompensation", 1.0 * cmn_ms,
+                                                        robfile, Rtw0),
+                             false);
+
+    vctDynamicMatrix<double> Kp(7, 7, 0.0), Kd(7, 7, 0.0);
+    Kp.Diagonal().SetAll(100.0);
+    Kd.Diagonal().SetAll(5.0);
+    passed &= TestController(new mtsPDGC("PDGC", 1.0 * cmn_ms, robfile, Rtw0,
+                                         Kp, Kd, vctDynamicVector<double>(7, 0.0)),
+                             true);
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*
+  osaPIDAntiWindup::Evaluate must not allocate once tau is sized, for
+  both the vector and the view versions.
+*/
+
+#include <cmath>
+
+#include <sawControllers/osaPIDAntiWindup.h>
+
+#include "sawControllersAllocations.h"
+
+int main(void)
+{
+    const size_t numberOfJoints = 7;
+    const size_t iterations = 10000;
+    osaPIDAntiWindup pid(vctDynamicVector<double>(numberOfJoints, 100.0),
+                         vctDynamicVector<double>(numberOfJoints, 1.0),
+                         vctDynamicVector<double>(numberOfJoints, 5.0),
+                         vctDynamicVector<double>(numberOfJoints, 0.1),
+                         vctDynamicVector<double>(numberOfJoints, 10.0),
+                         vctDynamicVector<double>(numberOfJoints, 0.0));
+    vctDynamicVector<double> qs(numberOfJoints, 0.0), q(numberOfJoints, 0.0), tau;
+
+    bool passed = true;
+    size_t start = 0;
+    // first calls are allowed to allocate (tau)
+    for (size_t i = 0; i < (iterations + 100); ++i) {
+        if (i == 100) {
+            start = NumberOfAllocations;
+        }
+        for (size_t joint = 0; joint < numberOfJoints; ++joint) {
+            qs[joint] = 0.5 * sin(0.001 * i + joint);
+            q[joint] = 0.5 * sin(0.001 * (i - 3) + joint);
+        }
+        if (pid.Evaluate(qs, q, tau, 0.001) != osaPIDAntiWindup::ESUCCESS) {
+            fprintf(stderr, "osaPIDAntiWindup: Evaluate failed\n");
+            return 1;
+        }
+    }
+    passed &= CheckNoAllocation("osaPIDAntiWindup-vector", start, iterations);
+
+    start = NumberOfAllocations;
+    for (size_t i = 0; i < iterations; ++i) {
+        qs[i % numberOfJoints] += 1.0e-4;
+        pid.Evaluate(vctDynamicConstVectorRef<double>(qs),
+                     vctDynamicConstVectorRef<double>(q),
+                     vctDynamicVectorRef<double>(tau), 0.001);
+    }
+    passed &= CheckNoAllocation("osaPIDAntiWindup-view", start, iterations);
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  CUHK-BRME
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*
+  Replaces the global operator new to count heap allocations, used by
+  the tests and by sawControllersBenchmarks.  Include in the file
+  defining main only, the programs are single threaded.
+*/
+
+#ifndef _sawControllersAllocations_h
+#define _sawControllersAllocations_h
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static size_t NumberOfAllocations = 0;
+
+void * operator new(std::size_t size)
+{
+    NumberOfAllocations++;
+    void * pointer = malloc(size == 0 ? 1 : size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void * operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void * pointer) throw()
+{
+    free(pointer);
+}
+
+void operator delete[](void * pointer) throw()
+{
+    free(pointer);
+}
+
+//! Print and return false if allocations happened since start
+inline bool CheckNoAllocation(const char * name, const size_t start, const size_t iterations)
+{
+    const size_t allocations = NumberOfAllocations - start;
+    if (allocations != 0) {
+        fprintf(stderr, "%s: %lu allocations in %lu iterations after warm up\n",
+                name, static_cast<unsigned long>(allocations),
+                static_cast<unsigned long>(iterations));
+        return false;
+    }
+    printf("%s: no allocation in %lu iterations\n",
+           name, static_cast<unsigned long>(iterations));
+    return true;
+}
+
+#endif // _sawControllersAllocations_h